@@ -0,0 +1,437 @@
+/**
+    @brief Benchmark suite of every executor of the engine.
+    For each grid size, rule, thread count and backend (the name of an executor, see executor.hpp) the automaton runs the same initial grid warmup times and then
+    repetitions times, each run is timed on the monotonic clock and reported in cells per second (rows * columns * steps
+    / seconds). The initial grids come from a std::mt19937 with a fixed seed, so two runs of the suite with the same
+    options compute exactly the same generations. The results are printed as a table and, on request, written as JSON
+    and CSV.
+    With --counters the hardware counters of the repetitions are read too (see perfcounters.hpp), and reported per run
+    with metrics per cell. The bytes per cell are the last-level cache misses times the line size, the traffic to memory
+    they cause.
+    With --autotune the automaton of each size and rule is also tuned (see CellularAutomata::autotune()), with the
+    configurations cached in the given file, and the tuned configuration is timed like the other backends, as tuned-<backend>.
+    Usage: benchmark [--sizes 512,2048] [--rules life,brian] [--threads 1,2,4] [--backends seq,threads,omp,ffpf,farm]
+                     [--steps 20] [--warmup 1] [--repetitions 5] [--seed 42] [--json file] [--csv file] [--counters]
+                     [--autotune cache]
+    @file benchmark.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <ctime>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+#include "rules.hpp"
+#include "cellularautomata.hpp"
+#include "perfcounters.hpp"
+
+#define CACHE_LINE_BYTES 64 /**<Bytes moved by a last-level cache miss*/
+
+struct BenchRule
+{
+    std::string name;
+    int (*function)(neighbourhood);
+    int states;
+};
+
+//Rules of rules.hpp
+const std::vector<BenchRule> RULES = {{"life", gameOfLifeRule, 2}, {"brian", brianbrain, 3}};
+
+//Backends run by --backends all, in this order. The sequential one ignores the thread count
+const std::vector<std::string> ALL_BACKENDS = {"seq", "threads", "omp", "steal", "nsync", "wavefront", "temporal", "ffpf", "farm", "bitlife"};
+
+struct BenchOptions
+{
+    std::vector<int> sizes = {512, 2048};
+    std::vector<std::string> rules = {"life", "brian"};
+    std::vector<int> threads;
+    std::vector<std::string> backends = {"seq", "threads", "omp", "ffpf", "farm"};
+    int steps = 20, warmup = 1, repetitions = 5;
+    unsigned seed = 42;
+    std::string json, csv;
+    bool counters = false;
+    std::string autotune;  /**<Cache of the autotuner, empty when it's not run*/
+};
+
+struct BenchResult
+{
+    std::string backend, rule;
+    int size, threads, steps;
+    std::vector<double> seconds;   /**<Time of each repetition*/
+    double median, mean, variance; /**<Of the cells per second of the repetitions*/
+    PerfSample counters;           /**<Per repetition, with --counters*/
+};
+
+/**
+ Metrics derived from the counters, NAN when a counter they need isn't available
+*/
+struct DerivedMetrics
+{
+    double ipc, cycles_per_cell, instructions_per_cell, bytes_per_cell, branch_misses_per_cell, dtlb_misses_per_cell, cpu_utilization;
+
+    DerivedMetrics(const BenchResult &r)
+    {
+        const PerfSample &c = r.counters;
+        double cells = (double)r.size * r.size * r.steps, seconds = 0;
+        for (double s : r.seconds)
+            seconds += s / r.seconds.size();
+        auto per = [&c](int counter, double divisor) { return c.available[counter] ? c.value[counter] / divisor : NAN; };
+        ipc = c.available[PERF_CYCLES] ? per(PERF_INSTRUCTIONS, c.value[PERF_CYCLES]) : NAN;
+        cycles_per_cell = per(PERF_CYCLES, cells);
+        instructions_per_cell = per(PERF_INSTRUCTIONS, cells);
+        bytes_per_cell = per(PERF_LLC_MISSES, cells / CACHE_LINE_BYTES);
+        branch_misses_per_cell = per(PERF_BRANCH_MISSES, cells);
+        dtlb_misses_per_cell = per(PERF_DTLB_MISSES, cells);
+        //Busy threads on average
+        cpu_utilization = per(PERF_TASK_CLOCK, seconds * 1e9);
+    }
+};
+
+//Stream buffer dropping everything, the run methods print their utimer
+struct NullBuffer : std::streambuf
+{
+    int overflow(int c) override { return c; }
+};
+
+/**
+ Function splitting a comma-separated list
+*/
+std::vector<std::string> splitList(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+std::vector<int> splitIntegers(const std::string &list)
+{
+    std::vector<int> values;
+    for (const std::string &item : splitList(list))
+    {
+        int value = std::atoi(item.c_str());
+        if (value <= 0)
+        {
+            std::cerr << "Error: " << item << " isn't a positive integer" << std::endl;
+            exit(-1);
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
+BenchOptions parseOptions(int argc, char **argv)
+{
+    BenchOptions options;
+    //Powers of two up to the hardware threads, and the hardware threads themselves
+    int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (int t = 1; t < hardware; t *= 2)
+        options.threads.push_back(t);
+    options.threads.push_back(hardware);
+    for (int i = 1; i < argc; i++)
+    {
+        std::string key = argv[i];
+        if (key == "--counters")
+        {
+            options.counters = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Error: " << key << " needs a value" << std::endl;
+            exit(-1);
+        }
+        std::string value = argv[++i];
+        if (key == "--sizes")
+            options.sizes = splitIntegers(value);
+        else if (key == "--rules")
+            options.rules = splitList(value);
+        else if (key == "--threads")
+            options.threads = splitIntegers(value);
+        else if (key == "--backends")
+            options.backends = value == "all" ? std::vector<std::string>() : splitList(value);
+        else if (key == "--steps")
+            options.steps = splitIntegers(value)[0];
+        else if (key == "--warmup")
+            options.warmup = std::max(0, std::atoi(value.c_str()));
+        else if (key == "--repetitions")
+            options.repetitions = splitIntegers(value)[0];
+        else if (key == "--seed")
+            options.seed = std::stoul(value);
+        else if (key == "--json")
+            options.json = value;
+        else if (key == "--csv")
+            options.csv = value;
+        else if (key == "--autotune")
+            options.autotune = value;
+        else
+        {
+            std::cerr << "Error: unknown option " << key << std::endl;
+            exit(-1);
+        }
+    }
+    if (options.backends.empty())
+        options.backends = ALL_BACKENDS;
+    std::vector<std::string> executors = CellularAutomata::getExecutors();
+    for (const std::string &backend : options.backends)
+        if (std::find(executors.begin(), executors.end(), backend) == executors.end())
+        {
+            std::cerr << "Error: unknown backend " << backend << std::endl;
+            exit(-1);
+        }
+    for (const std::string &rule : options.rules)
+        if (std::none_of(RULES.begin(), RULES.end(), [&rule](const BenchRule &r) { return r.name == rule; }))
+        {
+            std::cerr << "Error: unknown rule " << rule << std::endl;
+            exit(-1);
+        }
+    return options;
+}
+
+/**
+ Function building the initial grid. Only the raw output of the engine is used, which the standard fixes,
+ so the grid is the same with every compiler
+*/
+grid2D seededGrid(int size, int states, unsigned seed)
+{
+    std::mt19937 engine(seed);
+    grid2D grid(size, std::vector<int>(size));
+    for (auto &row : grid)
+        for (int &cell : row)
+            cell = engine() % states;
+    return grid;
+}
+
+/**
+ Function computing the median, the mean and the sample variance of the cells per second of a result
+*/
+void summarize(BenchResult &result)
+{
+    double cells = (double)result.size * result.size * result.steps;
+    std::vector<double> rates;
+    for (double s : result.seconds)
+        rates.push_back(cells / s);
+    std::sort(rates.begin(), rates.end());
+    size_t n = rates.size();
+    result.median = n % 2 ? rates[n / 2] : (rates[n / 2 - 1] + rates[n / 2]) / 2;
+    result.mean = 0;
+    for (double r : rates)
+        result.mean += r / n;
+    result.variance = 0;
+    for (double r : rates)
+        result.variance += (r - result.mean) * (r - result.mean) / std::max<size_t>(1, n - 1);
+}
+
+/**
+ Function timing a backend: the grid is reset before every run, out of the timed region
+ @param reset restores the initial grid
+ @param run runs the steps
+ @param result filled with the time, and the counters, of each repetition
+*/
+void timeBackend(const BenchOptions &options, const std::function<void()> &reset, const std::function<void()> &run, BenchResult &result)
+{
+    NullBuffer null;
+    PerfCounters counters;
+    for (int i = 0; i < options.warmup + options.repetitions; i++)
+    {
+        reset();
+        std::streambuf *out = std::cout.rdbuf(&null);
+        //The counters are opened out of the timed region, the warm-up runs created the threads they follow
+        bool counted = options.counters && i >= options.warmup && counters.start();
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto stop = std::chrono::steady_clock::now();
+        PerfSample sample = counted ? counters.stop() : PerfSample();
+        std::cout.rdbuf(out);
+        if (i < options.warmup)
+            continue;
+        result.seconds.push_back(std::chrono::duration<double>(stop - start).count());
+        if (i == options.warmup)
+            result.counters = sample;
+        else
+            result.counters.add(sample);
+    }
+    for (double &value : result.counters.value)
+        value /= options.repetitions;
+}
+
+//Counter or metric, n/a when it isn't available
+std::string formatMetric(double value)
+{
+    if (std::isnan(value))
+        return "n/a";
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3g", value);
+    return buffer;
+}
+
+//JSON number, null when it isn't available
+std::string jsonNumber(double value)
+{
+    if (std::isnan(value))
+        return "null";
+    std::ostringstream stream;
+    stream << std::setprecision(17) << value;
+    return stream.str();
+}
+
+void printResult(const BenchOptions &options, const BenchResult &result)
+{
+    std::cout << std::left << std::setw(16) << result.backend << std::setw(7) << result.rule << std::right
+              << std::setw(7) << result.size << std::setw(8) << result.threads << std::scientific << std::setprecision(3)
+              << std::setw(13) << result.median << std::setw(13) << result.mean << std::setw(13)
+              << std::sqrt(result.variance) << std::defaultfloat << std::endl;
+    if (!options.counters)
+        return;
+    DerivedMetrics d(result);
+    std::cout << "    ipc " << formatMetric(d.ipc) << ", cycles/cell " << formatMetric(d.cycles_per_cell)
+              << ", instructions/cell " << formatMetric(d.instructions_per_cell) << ", bytes/cell " << formatMetric(d.bytes_per_cell)
+              << ", branch misses/cell " << formatMetric(d.branch_misses_per_cell) << ", dTLB misses/cell "
+              << formatMetric(d.dtlb_misses_per_cell) << ", busy threads " << formatMetric(d.cpu_utilization) << std::endl;
+}
+
+void writeJson(const std::string &path, const BenchOptions &options, const std::vector<BenchResult> &results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Error: can't open " << path << std::endl;
+        exit(-1);
+    }
+    file << std::setprecision(17);
+    file << "{\n  \"seed\": " << options.seed << ", \"steps\": " << options.steps << ", \"warmup\": " << options.warmup
+         << ", \"repetitions\": " << options.repetitions << ",\n  \"hardware_threads\": "
+         << std::thread::hardware_concurrency() << ", \"compiler\": \"" << __VERSION__ << "\", \"timestamp\": "
+         << std::time(nullptr) << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        file << (i ? "," : "") << "\n    {\"backend\": \"" << r.backend << "\", \"rule\": \"" << r.rule
+             << "\", \"rows\": " << r.size << ", \"columns\": " << r.size << ", \"threads\": " << r.threads
+             << ", \"median_cells_per_second\": " << r.median << ", \"mean_cells_per_second\": " << r.mean
+             << ", \"variance\": " << r.variance << ", \"seconds\": [";
+        for (size_t j = 0; j < r.seconds.size(); j++)
+            file << (j ? ", " : "") << r.seconds[j];
+        file << "]";
+        if (options.counters)
+        {
+            DerivedMetrics d(r);
+            file << ",\n     \"counters\": {";
+            for (int c = 0; c < PERF_COUNTERS; c++)
+                file << (c ? ", " : "") << "\"" << PerfSample::name(c) << "\": " << jsonNumber(r.counters.available[c] ? r.counters.value[c] : NAN);
+            file << "},\n     \"derived\": {\"ipc\": " << jsonNumber(d.ipc) << ", \"cycles_per_cell\": " << jsonNumber(d.cycles_per_cell)
+                 << ", \"instructions_per_cell\": " << jsonNumber(d.instructions_per_cell) << ", \"bytes_per_cell\": "
+                 << jsonNumber(d.bytes_per_cell) << ", \"branch_misses_per_cell\": " << jsonNumber(d.branch_misses_per_cell)
+                 << ", \"dtlb_misses_per_cell\": " << jsonNumber(d.dtlb_misses_per_cell) << ", \"busy_threads\": "
+                 << jsonNumber(d.cpu_utilization) << "}";
+        }
+        file << "}";
+    }
+    file << "\n  ]\n}\n";
+}
+
+void writeCsv(const std::string &path, const BenchOptions &options, const std::vector<BenchResult> &results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cerr << "Error: can't open " << path << std::endl;
+        exit(-1);
+    }
+    file << std::setprecision(17);
+    file << "backend,rule,rows,columns,threads,steps,repetitions,median_cells_per_second,mean_cells_per_second,variance";
+    if (options.counters)
+    {
+        for (int c = 0; c < PERF_COUNTERS; c++)
+            file << "," << PerfSample::name(c);
+        file << ",ipc,cycles_per_cell,instructions_per_cell,bytes_per_cell,branch_misses_per_cell,dtlb_misses_per_cell,busy_threads";
+    }
+    file << "\n";
+    for (const BenchResult &r : results)
+    {
+        file << r.backend << "," << r.rule << "," << r.size << "," << r.size << "," << r.threads << "," << r.steps << ","
+             << r.seconds.size() << "," << r.median << "," << r.mean << "," << r.variance;
+        if (options.counters)
+        {
+            //The counters that aren't available are left empty
+            DerivedMetrics d(r);
+            for (int c = 0; c < PERF_COUNTERS; c++)
+                file << "," << (r.counters.available[c] ? jsonNumber(r.counters.value[c]) : "");
+            for (double metric : {d.ipc, d.cycles_per_cell, d.instructions_per_cell, d.bytes_per_cell, d.branch_misses_per_cell, d.dtlb_misses_per_cell, d.cpu_utilization})
+                file << "," << (std::isnan(metric) ? "" : jsonNumber(metric));
+        }
+        file << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions options = parseOptions(argc, argv);
+    std::vector<BenchResult> results;
+    std::cout << std::left << std::setw(16) << "backend" << std::setw(7) << "rule" << std::right << std::setw(7)
+              << "size" << std::setw(8) << "threads" << std::setw(13) << "median c/s" << std::setw(13) << "mean c/s"
+              << std::setw(13) << "stddev c/s" << std::endl;
+
+    for (int size : options.sizes)
+        for (const std::string &rule_name : options.rules)
+        {
+            const BenchRule &rule = *std::find_if(RULES.begin(), RULES.end(), [&rule_name](const BenchRule &r) { return r.name == rule_name; });
+            grid2D initial = seededGrid(size, rule.states, options.seed);
+            //One automaton per grid, sized like it, runs every backend
+            CellularAutomata automata(size, size, rule.function, options.steps, initial, options.threads[0]);
+            for (size_t t = 0; t < options.threads.size(); t++)
+                for (const std::string &backend : options.backends)
+                {
+                    if (backend == "seq" && t > 0)
+                        continue;
+                    int threads = backend == "seq" ? 1 : options.threads[t];
+                    automata.setNumThreads(threads);
+                    BenchResult result;
+                    result.backend = backend;
+                    result.rule = rule.name;
+                    result.size = size;
+                    result.threads = threads;
+                    result.steps = options.steps;
+                    timeBackend(options, [&automata, &initial]() { automata.setGrid(initial); }, [&automata, &backend]() { automata.run(backend); }, result);
+                    summarize(result);
+                    printResult(options, result);
+                    results.push_back(result);
+                }
+            if (!options.autotune.empty())
+            {
+                //The tuner restores the grid and applies the configuration it returns
+                TunedConfig tuned = automata.autotune(options.autotune);
+                BenchResult result;
+                result.backend = "tuned-" + tuned.backend;
+                result.rule = rule.name;
+                result.size = size;
+                result.threads = tuned.threads;
+                result.steps = options.steps;
+                timeBackend(options, [&automata, &initial]() { automata.setGrid(initial); }, [&automata, &tuned]() { automata.run(tuned.backend); }, result);
+                summarize(result);
+                printResult(options, result);
+                results.push_back(result);
+            }
+        }
+
+    if (!options.json.empty())
+        writeJson(options.json, options, results);
+    if (!options.csv.empty())
+        writeCsv(options.csv, options, results);
+    return 0;
+}
@@ -3,20 +3,15 @@
 int main(){
     
     CellularAutomataff ca(10000,10000,gameOfLifeRule,10, 2, 2);
-    std::cout << "2 Threads" << std::endl;
-    ca.fastFlowParallelFor();
-    ca.restartGrid();
-    ca.setNumThreads(4);
-    std::cout << "4 Threads:" << std::endl;
-    ca.fastFlowParallelFor();
-    ca.restartGrid();
-    ca.setNumThreads(8);
-    std::cout << "8 Threads:" << std::endl;
-    ca.fastFlowParallelFor();
-    ca.restartGrid();
-    ca.setNumThreads(10);
-    std::cout << " 12 Threads "<< std::endl;
-    ca.fastFlowParallelFor();
+    std::cout << ca.topologyReport();
+    //The label is printed from the thread count, see ../Benchmark for the measurements
+    for (int threads : {2, 4, 8, 10})
+    {
+        ca.setNumThreads(threads);
+        std::cout << threads << " Threads:" << std::endl;
+        ca.fastFlowParallelFor();
+        ca.restartGrid();
+    }
     
-    return(1);
-}
\ No newline at end of file
+    return(0);
+}
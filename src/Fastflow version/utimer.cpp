@@ -1,66 +0,0 @@
-#include <iostream>
-#include <chrono>
-#include <fstream>
-
-#define START(timename) auto timename = std::chrono::system_clock::now();
-#define STOP(timename,elapsed)  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - timename).count();
-
-
-class utimer {
-  std::chrono::system_clock::time_point start;
-  std::chrono::system_clock::time_point stop;
-  std::string message; 
-  using usecs = std::chrono::microseconds;
-  using msecs = std::chrono::milliseconds;
-
-private:
-  long * us_elapsed;
-  
-public:
-
-  utimer(const std::string m) : message(m),us_elapsed((long *)NULL) {
-    start = std::chrono::system_clock::now();
-  }
-    
-  utimer(const std::string m, long * us) : message(m),us_elapsed(us) {
-    start = std::chrono::system_clock::now();
-  }
-
-  auto getTime(){
-    stop =
-      std::chrono::system_clock::now();
-    std::chrono::duration<double> elapsed =
-      stop - start;
-    auto musec =
-      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
-      return musec;
-  }
-
-  void printOnReport(){
-    stop =
-      std::chrono::system_clock::now();
-    std::chrono::duration<double> elapsed =
-      stop - start;
-    auto musec =
-      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
-    std::ofstream myfile;
-    myfile.open("report2.txt", std::ios::app);
-    myfile << message << "\tcomputed in " << musec << "usec" << std::endl;
-    myfile.close();
-  }
-
-
-  ~utimer() {
-    stop =
-      std::chrono::system_clock::now();
-    std::chrono::duration<double> elapsed =
-      stop - start;
-    auto musec =
-      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
-    
-    std::cout << message << " computed in " << musec << " usec " 
-	      << "\n";
-    if(us_elapsed != NULL)
-      (*us_elapsed) = musec;
-  }
-};
@@ -0,0 +1,251 @@
+#include "cellularautomatampi.hpp"
+#include "rules.hpp"
+
+/**
+    @brief Class and methods body of the cellularautomatampi.hpp file.
+    For more detail about what the function does, please, consult the cellularautomatampi.hpp file.
+    The direction of a neighbour process is (di, dj), with di and dj in {-1, 0, 1}: the halo exchanged in direction
+    d = (di + 1) * 3 + (dj + 1) is sent with tag d, so the process on the other side receives it with tag 8 - d.
+    @file cellularautomatampi.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#define GRID_TAG 16 /**<Tag of the messages used to scatter and gather the grid*/
+
+CellularAutomataMPI::CellularAutomataMPI(int rows, int columns, int (*function)(neighbourhood), int tsteps, const grid2D &initial_state,
+                                         int numthreads, int halo_width, MPI_Comm communicator)
+{
+    if (checkParameters(rows, columns, function, tsteps, numthreads, halo_width) == false)
+        MPI_Abort(communicator, -1);
+    num_rows = rows;
+    num_columns = columns;
+    timesteps = tsteps;
+    rule = function;
+    num_threads = numthreads;
+    halo = halo_width;
+
+    //Periodic process grid, as close to a square as possible
+    MPI_Comm_size(communicator, &size);
+    int periods[2] = {1, 1};
+    dims[0] = dims[1] = 0;
+    MPI_Dims_create(size, 2, dims);
+    MPI_Cart_create(communicator, 2, dims, periods, 1, &comm);
+    MPI_Comm_rank(comm, &rank);
+    MPI_Cart_coords(comm, rank, 2, coords);
+    for (int di = -1; di <= 1; di++)
+        for (int dj = -1; dj <= 1; dj++)
+        {
+            int neighbour[2] = {(coords[0] + di + dims[0]) % dims[0], (coords[1] + dj + dims[1]) % dims[1]};
+            MPI_Cart_rank(comm, neighbour, &neighbours[di + 1][dj + 1]);
+        }
+
+    //The halo must come from the adjacent blocks only
+    if (num_rows / dims[0] < halo || num_columns / dims[1] < halo)
+    {
+        if (rank == 0)
+            std::cerr << "Error: the blocks of a " << dims[0] << "x" << dims[1] << " process grid are smaller than the halo" << std::endl;
+        MPI_Abort(comm, -1);
+    }
+    first_row = blockBegin(num_rows, dims[0], coords[0]);
+    first_column = blockBegin(num_columns, dims[1], coords[1]);
+    local_rows = blockSize(num_rows, dims[0], coords[0]);
+    local_columns = blockSize(num_columns, dims[1], coords[1]);
+    buffers[0] = FlatGrid(local_rows + 2 * halo, local_columns + 2 * halo);
+    buffers[1] = FlatGrid(local_rows + 2 * halo, local_columns + 2 * halo);
+
+    //Strided regions of the buffers: local_rows or halo rows times local_columns or halo columns
+    for (int di = -1; di <= 1; di++)
+        for (int dj = -1; dj <= 1; dj++)
+        {
+            regions[di + 1][dj + 1] = MPI_DATATYPE_NULL;
+            if (di == 0 && dj == 0)
+                continue;
+            MPI_Type_vector(di == 0 ? local_rows : halo, dj == 0 ? local_columns : halo, buffers[0].getStride(), MPI_INT, &regions[di + 1][dj + 1]);
+            MPI_Type_commit(&regions[di + 1][dj + 1]);
+        }
+
+    //The number of states is needed by the lookup tables
+    if (rank == 0)
+    {
+        states = 2;
+        for (const std::vector<int> &row : initial_state)
+            for (int cell : row)
+                states = std::max(states, cell + 1);
+    }
+    MPI_Bcast(&states, 1, MPI_INT, 0, comm);
+    setGrid(initial_state);
+}
+
+CellularAutomataMPI::~CellularAutomataMPI()
+{
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            if (regions[i][j] != MPI_DATATYPE_NULL)
+                MPI_Type_free(&regions[i][j]);
+    MPI_Comm_free(&comm);
+}
+
+//The run method is a template defined in cellularautomatampi.hpp, here the classic rule is replaced by the fastest functor available
+void CellularAutomataMPI::run()
+{
+    withCompiledRule([this](const auto &r) { run(r); });
+}
+
+int CellularAutomataMPI::blockBegin(int total, int parts, int index)
+{
+    //The first (total % parts) blocks get one more row
+    return index * (total / parts) + std::min(index, total % parts);
+}
+
+int CellularAutomataMPI::blockSize(int total, int parts, int index)
+{
+    return total / parts + (index < total % parts ? 1 : 0);
+}
+
+int CellularAutomataMPI::regionBegin(int d, int local, bool receive)
+{
+    if (d == 0)
+        return halo;
+    if (d < 0)
+        return receive ? 0 : halo;
+    return receive ? halo + local : local;
+}
+
+void CellularAutomataMPI::startExchange()
+{
+    FlatGrid &current = buffers[current_index];
+    int n = 0;
+    for (int d = 0; d < 9; d++)
+    {
+        if (d == 4)
+            continue;
+        int di = d / 3 - 1, dj = d % 3 - 1;
+        int *halo_region = current.row(regionBegin(di, local_rows, true)) + regionBegin(dj, local_columns, true);
+        int *edge_region = current.row(regionBegin(di, local_rows, false)) + regionBegin(dj, local_columns, false);
+        MPI_Irecv(halo_region, 1, regions[di + 1][dj + 1], neighbours[di + 1][dj + 1], 8 - d, comm, &requests[n++]);
+        MPI_Isend(edge_region, 1, regions[di + 1][dj + 1], neighbours[di + 1][dj + 1], d, comm, &requests[n++]);
+    }
+}
+
+void CellularAutomataMPI::finishExchange()
+{
+    MPI_Waitall(16, requests, MPI_STATUSES_IGNORE);
+}
+
+void CellularAutomataMPI::setGrid(const grid2D &new_grid)
+{
+    FlatGrid &current = buffers[current_index];
+    if (rank == 0)
+    {
+        if ((int)new_grid.size() != num_rows || (int)new_grid[0].size() != num_columns)
+        {
+            std::cerr << "Error: the grid doesn't match the size of the automaton" << std::endl;
+            MPI_Abort(comm, -1);
+        }
+        std::vector<int> block;
+        for (int r = 0; r < size; r++)
+        {
+            int c[2];
+            MPI_Cart_coords(comm, r, 2, c);
+            int row = blockBegin(num_rows, dims[0], c[0]), rows = blockSize(num_rows, dims[0], c[0]);
+            int column = blockBegin(num_columns, dims[1], c[1]), columns = blockSize(num_columns, dims[1], c[1]);
+            if (r == rank)
+            {
+                for (int i = 0; i < rows; i++)
+                    std::copy(new_grid[row + i].begin() + column, new_grid[row + i].begin() + column + columns, current.row(halo + i) + halo);
+                continue;
+            }
+            block.resize((size_t)rows * columns);
+            for (int i = 0; i < rows; i++)
+                std::copy(new_grid[row + i].begin() + column, new_grid[row + i].begin() + column + columns, block.begin() + (size_t)i * columns);
+            MPI_Send(block.data(), rows * columns, MPI_INT, r, GRID_TAG, comm);
+        }
+    }
+    else
+    {
+        std::vector<int> block((size_t)local_rows * local_columns);
+        MPI_Recv(block.data(), local_rows * local_columns, MPI_INT, 0, GRID_TAG, comm, MPI_STATUS_IGNORE);
+        for (int i = 0; i < local_rows; i++)
+            std::copy(block.begin() + (size_t)i * local_columns, block.begin() + (size_t)(i + 1) * local_columns, current.row(halo + i) + halo);
+    }
+}
+
+grid2D CellularAutomataMPI::getGrid()
+{
+    const FlatGrid &current = buffers[current_index];
+    if (rank != 0)
+    {
+        std::vector<int> block((size_t)local_rows * local_columns);
+        for (int i = 0; i < local_rows; i++)
+            std::copy(current.row(halo + i) + halo, current.row(halo + i) + halo + local_columns, block.begin() + (size_t)i * local_columns);
+        MPI_Send(block.data(), local_rows * local_columns, MPI_INT, 0, GRID_TAG, comm);
+        return grid2D();
+    }
+    grid2D whole(num_rows, std::vector<int>(num_columns));
+    std::vector<int> block;
+    for (int r = 0; r < size; r++)
+    {
+        int c[2];
+        MPI_Cart_coords(comm, r, 2, c);
+        int row = blockBegin(num_rows, dims[0], c[0]), rows = blockSize(num_rows, dims[0], c[0]);
+        int column = blockBegin(num_columns, dims[1], c[1]), columns = blockSize(num_columns, dims[1], c[1]);
+        if (r == rank)
+        {
+            for (int i = 0; i < rows; i++)
+                std::copy(current.row(halo + i) + halo, current.row(halo + i) + halo + columns, whole[row + i].begin() + column);
+            continue;
+        }
+        block.resize((size_t)rows * columns);
+        MPI_Recv(block.data(), rows * columns, MPI_INT, r, GRID_TAG, comm, MPI_STATUS_IGNORE);
+        for (int i = 0; i < rows; i++)
+            std::copy(block.begin() + (size_t)i * columns, block.begin() + (size_t)(i + 1) * columns, whole[row + i].begin() + column);
+    }
+    return whole;
+}
+
+bool CellularAutomataMPI::checkParameters(int rows, int columns, int (*function)(neighbourhood), int tsteps, int numthreads, int halo_width)
+{
+    bool flag = true;
+
+    if (rows <= 0 || columns <= 0)
+    {
+        std::cerr << "Error: rows or columns value wasn't valid" << std::endl;
+        flag = false;
+    }
+
+    if (tsteps <= 0)
+    {
+        std::cerr << "Error: timesteps values wasn't strictly positive" << std::endl;
+        flag = false;
+    }
+
+    if (numthreads <= 0)
+    {
+        std::cerr << "Error: the number of threads wasn't strictly positive" << std::endl;
+        flag = false;
+    }
+
+    if (halo_width <= 0)
+    {
+        std::cerr << "Error: the halo width wasn't strictly positive" << std::endl;
+        flag = false;
+    }
+
+    if (function == nullptr)
+    {
+        std::cerr << "Error: rule provided wasn't valid" << std::endl;
+        flag = false;
+    }
+    return flag;
+}
+
+int CellularAutomataMPI::getRank() { return rank; }
+int CellularAutomataMPI::getSize() { return size; }
+int CellularAutomataMPI::getRows() { return num_rows; }
+int CellularAutomataMPI::getColumns() { return num_columns; }
+int CellularAutomataMPI::getLocalRows() { return local_rows; }
+int CellularAutomataMPI::getLocalColumns() { return local_columns; }
+int CellularAutomataMPI::getTimeSteps() { return timesteps; }
+int CellularAutomataMPI::getHalo() { return halo; }
+void CellularAutomataMPI::setTimeSteps(int tsteps) { timesteps = tsteps; }
@@ -0,0 +1,209 @@
+/**
+    @brief Class and methods for Cellular automata computation distributed over MPI processes
+    The toroidal grid is split in 2D blocks over a periodic cartesian grid of processes. Each process stores its block
+    surrounded by a halo of width k, exchanged with the 8 neighbour processes through non-blocking messages
+    which are received in place (no packing, MPI vector datatypes describe the strided regions).
+    After an exchange the block is advanced k generations, as in the temporal blocking of the normal version,
+    and the first generation of the cells which don't depend on the halo is computed while the messages are in flight.
+    @file cellularautomatampi.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <mpi.h>
+#include <omp.h>
+#include "utimer.cpp"
+#include "grid.hpp"
+#include "stencil.hpp"
+#include "totalistic.hpp"
+#include "lut.hpp"
+#include "rules.hpp"
+#ifndef CELLULAR_AUTOMATA_MPI_H
+#define CELLULAR_AUTOMATA_MPI_H
+
+//Defining aliases
+using neighbourhood = std::vector<int>;
+using grid2D = std::vector<std::vector<int>>;
+
+class CellularAutomataMPI
+{
+private:
+    MPI_Comm comm;                                      /**<Periodic cartesian communicator*/
+    int rank, size, dims[2], coords[2];                 /**<Position of the process in the process grid*/
+    int neighbours[3][3];                               /**<Rank of the neighbour process in direction (di + 1, dj + 1)*/
+    MPI_Datatype regions[3][3];                         /**<Halo-sized regions of the local buffers, indexed as neighbours*/
+    int num_rows, num_columns, states, timesteps;       /**<Global Cellular Automata params*/
+    int num_threads;                                    /**<OpenMP threads used inside a process*/
+    int halo;                                           /**<Width of the halo, i.e. generations computed per exchange*/
+    int first_row, first_column;                        /**<Global position of the block*/
+    int local_rows, local_columns;                      /**<Size of the block*/
+    FlatGrid buffers[2];                                /**<Block plus halo, current and next generation*/
+    int current_index = 0;                              /**<Index of the buffer holding the current generation*/
+    int (*rule)(neighbourhood) = nullptr;               /**<Cellular Automata update rule*/
+    RuleTable table;                                    /**<Lookup table compiled from the rule, when it has few states*/
+    MPI_Request requests[16];                           /**<Receive and send of the halo regions of the current exchange*/
+
+    /**
+     Method returning the first row (or column) of a block and its size
+     @param total number of rows (or columns) of the grid
+     @param parts number of blocks along that dimension
+     @param index index of the block
+    */
+    static int blockBegin(int total, int parts, int index);
+    static int blockSize(int total, int parts, int index);
+
+    /**
+     Method returning the first row (or column) of the region of the local buffer sent to (received from) direction d
+     @param d direction, -1, 0 or 1
+     @param local size of the block along that dimension
+     @param receive true for the halo region, false for the owned cells sent to the neighbour
+    */
+    int regionBegin(int d, int local, bool receive);
+
+    /**
+     Methods starting the non-blocking exchange of the halo of the current buffer and waiting for its end
+    */
+    void startExchange();
+    void finishExchange();
+
+    /**
+     Method computing the cells [row_begin, row_end[ x [column_begin, column_end[ of the local buffers
+    */
+    template <typename Rule>
+    void sweepRegion(int row_begin, int row_end, int column_begin, int column_end, const Rule &r);
+
+    /**
+     Method calling body with the fastest functor equivalent to the rule pointer (see the normal version)
+    */
+    template <typename Body>
+    void withCompiledRule(const Body &body);
+
+public:
+    /**
+      Constructor, it's collective over the communicator
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param function rule to use in order to compute grid's next state
+      @param tsteps number of generation executed
+      @param initial_state initial grid, only read on rank 0
+      @param numthreads number of OpenMP threads used by each process
+      @param halo_width generations computed between two halo exchanges, each block must be at least this large
+      @param communicator processes taking part to the simulation
+     */
+    CellularAutomataMPI(int rows, int columns, int (*function)(neighbourhood), int tsteps, const grid2D &initial_state,
+                        int numthreads = 1, int halo_width = 1, MPI_Comm communicator = MPI_COMM_WORLD);
+
+    ~CellularAutomataMPI();
+
+    //The object owns MPI handles, it can't be copied. It has to be destroyed before MPI_Finalize()
+    CellularAutomataMPI(const CellularAutomataMPI &) = delete;
+    CellularAutomataMPI &operator=(const CellularAutomataMPI &) = delete;
+
+    /**
+     Method running the simulation, it's collective
+    */
+    void run();
+
+    /**
+     Templated version of run(). The rule is a functor type (see stencil.hpp and rules.hpp)
+     @param r rule used to compute the next state of each cell
+    */
+    template <typename Rule>
+    void run(const Rule &r);
+
+    /**
+     Method scattering a grid2D, read on rank 0, to the processes. It's collective
+     @param new_grid grid with the global size
+    */
+    void setGrid(const grid2D &new_grid);
+
+    /**
+     Method gathering the grid on rank 0. It's collective
+     @returns the whole grid on rank 0, an empty grid on the other ranks
+    */
+    grid2D getGrid();
+
+    /**
+     Method which check the correctness of some of the constructor's parameters.
+     @returns whether the parameters are correct or not
+    */
+    bool checkParameters(int rows, int columns, int (*function)(neighbourhood), int tsteps, int numthreads, int halo_width);
+
+    /**
+     Setter and Getter methods
+    */
+    int getRank();
+    int getSize();
+    int getRows();
+    int getColumns();
+    int getLocalRows();
+    int getLocalColumns();
+    int getTimeSteps();
+    int getHalo();
+    void setTimeSteps(int tsteps);
+};
+
+template <typename Body>
+void CellularAutomataMPI::withCompiledRule(const Body &body)
+{
+    OuterTotalisticRule totalistic;
+    if (totalisticEquivalent(rule, states, &totalistic))
+        body(OuterTotalistic{totalistic});
+    else if (table.compile(rule, states))
+    {
+        if (table.isTotalistic())
+            body(table.totalisticLookup());
+        else if (states == 2)
+            body(table.binaryLookup());
+        else
+            body(table.patternLookup());
+    }
+    else
+        body(FunctionRule{rule});
+}
+
+template <typename Rule>
+void CellularAutomataMPI::sweepRegion(int row_begin, int row_end, int column_begin, int column_end, const Rule &r)
+{
+    const FlatGrid &src = buffers[current_index];
+    FlatGrid &dst = buffers[current_index ^ 1];
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+    for (int i = row_begin; i < row_end; i++)
+        stencilSweep(src, dst, i, i + 1, column_begin, column_end, r);
+}
+
+template <typename Rule>
+void CellularAutomataMPI::run(const Rule &r)
+{
+    utimer tmpi("MPI execution time (rank " + std::to_string(rank) + "):");
+    //Size of the local buffers, generation g of a pass is valid on [g, height - g[ x [g, width - g[
+    int height = local_rows + 2 * halo, width = local_columns + 2 * halo;
+    for (int t = 0; t < timesteps; t += halo)
+    {
+        int steps = std::min(halo, timesteps - t);
+        startExchange();
+        //Cells whose neighbourhood is made of owned cells only, computed while the halo travels
+        int inner_top = halo + 1, inner_bottom = std::max(inner_top, halo + local_rows - 1);
+        int inner_left = halo + 1, inner_right = std::max(inner_left, halo + local_columns - 1);
+        sweepRegion(inner_top, inner_bottom, inner_left, inner_right, r);
+        finishExchange();
+        //The ring around them, which reads the halo
+        sweepRegion(1, inner_top, 1, width - 1, r);
+        sweepRegion(inner_bottom, height - 1, 1, width - 1, r);
+        sweepRegion(inner_top, inner_bottom, 1, inner_left, r);
+        sweepRegion(inner_top, inner_bottom, inner_right, width - 1, r);
+        current_index ^= 1;
+        for (int g = 2; g <= steps; g++)
+        {
+            sweepRegion(g, height - g, g, width - g, r);
+            current_index ^= 1;
+        }
+    }
+    //tmpi.printOnReport();
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include "rules.hpp"
+#include "cellularautomatampi.hpp"
+
+/*
+ Run with several processes, e.g. mpirun -np 4 ./mpisimulation
+ Rank 0 also computes the grid on its own, and the distributed results are compared with it.
+*/
+int main(int argc, char **argv)
+{
+   MPI_Init(&argc, &argv);
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   int rows = 1000, columns = 1000, steps = 40;
+
+   grid2D initial, expected;
+   if (rank == 0)
+   {
+      srand(42);
+      initial = grid2D(rows, std::vector<int>(columns));
+      for (auto &row : initial)
+         for (int &cell : row)
+            cell = rand() % 2;
+      PingPongGrid reference(initial);
+      for (int t = 0; t < steps; t++)
+      {
+         stencilSweep(reference.current(), reference.next(), 0, rows, GameOfLife());
+         reference.swap();
+      }
+      expected = reference.current().toGrid2D();
+   }
+
+   for (int halo : {1, 4})
+   {
+      CellularAutomataMPI ca(rows, columns, gameOfLifeRule, steps, initial, 1, halo);
+      ca.run();
+      grid2D result = ca.getGrid();
+      if (rank == 0)
+         std::cout << "Halo " << halo << " on " << ca.getSize() << " processes: " << (result == expected ? "correct" : "WRONG") << std::endl;
+   }
+   MPI_Finalize();
+}
@@ -1,28 +1,215 @@
 #include "rules.hpp"
 #include "cellularautomata.hpp"
+#include "hashlife.hpp"
+#include "largerthanlife.hpp"
 
+grid2D randomGrid(int rows, int columns, int states, unsigned seed)
+{
+   std::mt19937 engine(seed);
+   grid2D cells(rows, std::vector<int>(columns));
+   for (auto &row : cells)
+      for (int &cell : row)
+         cell = engine() % states;
+   return cells;
+}
+
+
+//The compiled rules have to give the grid of the function rule, e.g. gameOfLifeRule keeps the cells in state 2 and runs bit-packed with 2 states
+bool checkCompiledRule(int (*rule)(neighbourhood), int states)
+{
+   grid2D initial = randomGrid(64, 64, states, 42);
+   CellularAutomata reference(64, 64, rule, 8, initial, 2);
+   reference.sequentialRun(FunctionRule{rule});
+   bool same = true;
+   for (const std::string &backend : CellularAutomata::getExecutors())
+   {
+      if (backend == "ooc")
+         continue;
+      CellularAutomata ca(64, 64, rule, 8, initial, 2);
+      ca.run(backend);
+      if (ca.copyGrid() != reference.copyGrid())
+      {
+         std::cerr << "Error: " << backend << " differs from the function rule with " << states << " states" << std::endl;
+         same = false;
+      }
+   }
+   return same;
+}
+
+//HashLife has to give the grid of sequentialRun, on tori and, far from the border, on the unbounded plane
+bool checkHashLife()
+{
+   bool same = true;
+   auto compare = [&same](const grid2D &initial, int steps, bool torus, size_t limit, const std::string &label)
+   {
+      int rows = initial.size(), columns = initial[0].size();
+      CellularAutomata reference(rows, columns, gameOfLifeRule, steps, initial, 1);
+      reference.sequentialRun();
+      HashLife life(rows, columns, steps, initial, GAME_OF_LIFE_B3S23, torus, limit);
+      life.run();
+      if (life.getGrid() != reference.copyGrid() || life.getMemoryUsage() > limit)
+      {
+         std::cerr << "Error: HashLife differs from sequentialRun on " << label << " after " << steps << " steps" << std::endl;
+         same = false;
+      }
+   };
+   for (int side = 8; side <= 128; side *= 2)
+      for (int steps : {1, 5, 37, 100})
+         compare(randomGrid(side, side, 2, side + steps), steps, true, HASHLIFE_DEFAULT_MEMORY, "the " + std::to_string(side) + " torus");
+   compare(randomGrid(64, 64, 2, 7), 1000, true, 64 << 10, "the 64 torus with a 64 KiB limit");
+
+   //A 16x16 soup grows by a cell per step at most, so in 40 steps it doesn't reach the border of 160x200
+   grid2D plane(160, std::vector<int>(200));
+   grid2D soup = randomGrid(16, 16, 2, 11);
+   for (int i = 0; i < 16; i++)
+      for (int j = 0; j < 16; j++)
+         plane[72 + i][92 + j] = soup[i][j];
+   compare(plane, 40, false, HASHLIFE_DEFAULT_MEMORY, "the unbounded plane");
+   return same;
+}
+
+//An automaton continuing from a checkpoint, loaded into one of another size, has to reach the grid of the uninterrupted run
+bool checkCheckpoint()
+{
+   std::string path = "/tmp/ca_test_checkpoint.cack";
+   grid2D initial = randomGrid(150, 90, 3, 5);
+   CellularAutomata reference(150, 90, brianbrain, 30, initial, 2);
+   reference.ompParallelFor();
+   CellularAutomata interrupted(150, 90, brianbrain, 13, initial, 2);
+   interrupted.ompParallelFor();
+   interrupted.saveCheckpoint(path);
+
+   CellularAutomata restored(40, 40, brianbrain, 17, 3, 2);
+   restored.loadCheckpoint(path);
+   restored.ompParallelFor();
+   bool same = restored.copyGrid() == reference.copyGrid() && restored.getGeneration() == 30;
+   //The random generator is restored too
+   interrupted.restartGrid();
+   restored.restartGrid();
+   same = same && restored.copyGrid() == interrupted.copyGrid();
+   std::remove(path.c_str());
+   if (!same)
+      std::cerr << "Error: the run continued from the checkpoint differs from the uninterrupted one" << std::endl;
+   return same;
+}
+
+//Every frame read back from the snapshots, compressed or not and shadow or not, has to be the grid of its generation
+bool checkSnapshots()
+{
+   std::string path = "/tmp/ca_test_snapshots.casn";
+   bool same = true;
+   for (int states : {2, 3})
+   {
+      grid2D initial = randomGrid(50, 70, states, 9);
+      for (bool compress : {false, true})
+         for (bool shadow : {false, true})
+         {
+            CellularAutomata ca(50, 70, states == 2 ? gameOfLifeRule : brianbrain, 20, initial, 2);
+            ca.setSnapshots(path, 3, compress, shadow);
+            ca.threadsExecution();
+            ca.stopSnapshots();
+            SnapshotReader reader(path);
+            long generation, frames = 0;
+            bool ok = true;
+            grid2D frame;
+            for (; reader.next(generation, frame); frames++)
+            {
+               CellularAutomata reference(50, 70, states == 2 ? gameOfLifeRule : brianbrain, generation, initial, 1);
+               reference.sequentialRun();
+               ok = ok && generation == 3 * (frames + 1) && frame == reference.copyGrid();
+            }
+            if (frames != 6 || !ok)
+            {
+               std::cerr << "Error: wrong snapshots with " << states << " states, compress " << compress << " and shadow " << shadow << std::endl;
+               same = false;
+            }
+         }
+   }
+   std::remove(path.c_str());
+   return same;
+}
+
+//The out-of-core run has to give the grid of sequentialRun, also when the files are reopened by the path constructor
+bool checkOutOfCore()
+{
+   std::string first = "/tmp/ca_test_grid.cag", second = "/tmp/ca_test_next.cag";
+   grid2D initial = randomGrid(300, 200, 3, 13);
+   CellularAutomata halfway(300, 200, brianbrain, 13, initial, 1), reference(300, 200, brianbrain, 21, initial, 1);
+   halfway.sequentialRun();
+   reference.sequentialRun();
+   bool same;
+   {
+      CellularAutomata ca(300, 200, brianbrain, 13, initial, 2);
+      ca.setOutOfCore(first, second);
+      ca.outOfCoreRun();
+      same = ca.copyGrid() == halfway.copyGrid();
+   }
+   //After an odd number of steps the current generation is in the second file
+   {
+      CellularAutomata ca(second, first, brianbrain, 8, 3, 2);
+      ca.outOfCoreRun();
+      same = same && ca.copyGrid() == reference.copyGrid();
+   }
+   std::remove(first.c_str());
+   std::remove(second.c_str());
+   if (!same)
+      std::cerr << "Error: the out-of-core run differs from sequentialRun" << std::endl;
+   return same;
+}
+
+//The running sums of LargerThanLife have to give the counts of naiveCount(), also on grids smaller than the neighbourhood
+bool checkLargerThanLife()
+{
+   bool same = true;
+   for (NeighbourhoodShape shape : {MOORE, VON_NEUMANN, HEXAGONAL})
+      for (int radius : {1, 2, 5})
+         for (int side : {7, 150})
+         {
+            Neighbourhood nb(shape, radius);
+            int n = nb.size();
+            RadiusTotalisticRule rule{nb, 3, n / 4, n / 3, n / 5, n / 2, radius > 1};
+            LargerThanLife ltl(side, side - 3, 1, randomGrid(side, side - 3, 3, radius * side), 2, rule);
+            for (int t = 0; t < 3; t++)
+            {
+               grid2D expected = ltl.getGrid();
+               for (int i = 0; i < side; i++)
+                  for (int j = 0; j < side - 3; j++)
+                     expected[i][j] = rule.apply(expected[i][j], ltl.naiveCount(i, j));
+               //Each step with another run method
+               if (t == 0)
+                  ltl.sequentialRun();
+               else if (t == 1)
+                  ltl.threadsExecution();
+               else
+                  ltl.ompParallelFor();
+               if (ltl.getGrid() != expected)
+               {
+                  std::cerr << "Error: LargerThanLife differs from naiveCount with shape " << shape << ", radius " << radius
+                            << " and side " << side << " at step " << t << std::endl;
+                  same = false;
+               }
+            }
+         }
+   return same;
+}
 
 int main(){
+   if (!checkCompiledRule(gameOfLifeRule, 2) || !checkCompiledRule(gameOfLifeRule, 3) || !checkCompiledRule(brianbrain, 4) ||
+       !checkHashLife() || !checkCheckpoint() || !checkSnapshots() || !checkOutOfCore() || !checkLargerThanLife())
+      return -1;
+
    CellularAutomata ca(10000,10000, gameOfLifeRule, 40, 2, 2);
+   std::cout << ca.topologyReport();
 
-   std::cout << "2 Threads:" << std::endl;
    ca.sequentialRun();
    ca.restartGrid();
-   ca.threadsExecution();
-   ca.restartGrid();
-
-   ca.setNumThreads(4);
-   std::cout << "4 Threads:" << std::endl;
-   ca.threadsExecution();
-   ca.restartGrid();
-
-   ca.setNumThreads(8);
-   std::cout << "8 Threads:" << std::endl;
-   ca.threadsExecution();
-   ca.restartGrid();
 
-   ca.setNumThreads(11);
-   std::cout << "8 Threads:" << std::endl;
-   ca.threadsExecution();
-   ca.restartGrid();
+   //The label is printed from the thread count, see ../Benchmark for the measurements
+   for (int threads : {2, 4, 8, 11})
+   {
+      ca.setNumThreads(threads);
+      std::cout << threads << " Threads:" << std::endl;
+      ca.threadsExecution();
+      ca.restartGrid();
+   }
    }
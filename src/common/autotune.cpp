@@ -0,0 +1,89 @@
+#include "autotune.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <unistd.h>
+
+/**
+    @brief Methods body of the autotune.hpp file.
+    @file autotune.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+std::string machineId()
+{
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    std::string model = "unknown";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            model = line.substr(line.find(':') + 2);
+            break;
+        }
+    std::ostringstream id;
+    id << host << '/' << model << '/' << std::thread::hardware_concurrency();
+    //The key is split on tabs
+    std::string result = id.str();
+    for (char &c : result)
+        if (c == '\t')
+            c = ' ';
+    return result;
+}
+
+std::string tuneKey(int rows, int columns, uint64_t rule_id, int states)
+{
+    std::ostringstream key;
+    key << machineId() << '|' << rows << 'x' << columns << '|' << std::hex << rule_id << std::dec << '|' << states;
+    return key.str();
+}
+
+bool loadTunedConfig(const std::string &path, const std::string &key, TunedConfig &config)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.compare(0, tab, key) != 0 || tab != key.size())
+            continue;
+        std::istringstream fields(line.substr(tab + 1));
+        TunedConfig found;
+        if (fields >> found.backend >> found.threads >> found.tile_rows >> found.tile_columns >> found.grain >> found.cells_per_second)
+        {
+            config = found;
+            return true;
+        }
+    }
+    return false;
+}
+
+void saveTunedConfig(const std::string &path, const std::string &key, const TunedConfig &config)
+{
+    //The other keys are kept
+    std::vector<std::string> lines;
+    {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line))
+            if (line.compare(0, key.size() + 1, key + '\t') != 0)
+                lines.push_back(line);
+    }
+    std::ostringstream entry;
+    entry << key << '\t' << config.backend << ' ' << config.threads << ' ' << config.tile_rows << ' ' << config.tile_columns
+          << ' ' << config.grain << ' ' << config.cells_per_second;
+    lines.push_back(entry.str());
+    std::ofstream file(path, std::ios::trunc);
+    for (const std::string &line : lines)
+        file << line << '\n';
+    if (!file)
+    {
+        std::cerr << "Error: can't write the autotune cache " << path << std::endl;
+        exit(-1);
+    }
+}
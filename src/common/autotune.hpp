@@ -0,0 +1,56 @@
+/**
+    @brief Configuration chosen by the autotuner and its cache.
+    CellularAutomata::autotune() times short trial runs of the backends over thread counts and tile or chunk sizes, and
+    keeps the fastest. The result depends on the machine, the shape of the grid and the cost of the rule, so it's cached
+    under a key made of the three (see tuneKey()). The cache is a text file, one configuration per line:
+      key <TAB> backend threads tile_rows tile_columns grain cells_per_second
+    @file autotune.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <string>
+#include <cstdint>
+#ifndef CA_AUTOTUNE_H
+#define CA_AUTOTUNE_H
+
+#define DEFAULT_TUNE_CACHE "autotune.cache" /**<Cache of the tuned configurations, in the working directory*/
+#define DEFAULT_TUNE_STEPS 4                /**<Generations of a trial run*/
+#define TUNE_REPETITIONS 2                  /**<Runs of each trial, the fastest one counts*/
+
+struct TunedConfig
+{
+    std::string backend;           /**<Executor, see CellularAutomata::run()*/
+    int threads = 1;               /**<Number of threads*/
+    int tile_rows = 0;             /**<Tile size of the backend, 0 when it doesn't use tiles*/
+    int tile_columns = 0;
+    int grain = 1;                 /**<Bands per task of the FastFlow parallel for*/
+    double cells_per_second = 0;   /**<Measured by the trial*/
+};
+
+/**
+ Method describing the machine: host name, CPU model and hardware threads
+*/
+std::string machineId();
+
+/**
+ Method building the cache key of an automaton
+ @param rows number of rows of the grid
+ @param columns number of columns of the grid
+ @param rule_id fingerprint of the rule (see ruleId())
+ @param states number of states
+*/
+std::string tuneKey(int rows, int columns, uint64_t rule_id, int states);
+
+/**
+ Method looking for key in the cache
+ @returns whether the configuration was found, a missing or unreadable cache counts as empty
+*/
+bool loadTunedConfig(const std::string &path, const std::string &key, TunedConfig &config);
+
+/**
+ Method writing the configuration of key in the cache, replacing the previous one
+*/
+void saveTunedConfig(const std::string &path, const std::string &key, const TunedConfig &config);
+
+#endif
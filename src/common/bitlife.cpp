@@ -0,0 +1,208 @@
+#include "bitlife.hpp"
+#include <thread>
+#include <algorithm>
+#include <omp.h>
+#include "utimer.cpp"
+
+/**
+    @brief Methods body of the bitlife.hpp file.
+    Bit j of word w of a row holds the cell at column 64 * w + j.
+    @file bitlife.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+BitPackedLife::BitPackedLife(int rows, int columns, int tsteps, const grid2D &initial_state, int numthreads, LifeLikeRule r)
+{
+    allocate(rows, columns, tsteps, numthreads, r);
+    setGrid(initial_state);
+}
+
+BitPackedLife::BitPackedLife(int rows, int columns, int tsteps, const FlatGrid &initial_state, int numthreads, LifeLikeRule r)
+{
+    allocate(rows, columns, tsteps, numthreads, r);
+    setGrid(initial_state);
+}
+
+void BitPackedLife::allocate(int rows, int columns, int tsteps, int numthreads, LifeLikeRule r)
+{
+    num_rows = rows;
+    num_columns = columns;
+    timesteps = tsteps;
+    num_threads = numthreads;
+    rule = r;
+    words = (columns + 63) / 64;
+    last_mask = (columns % 64 == 0) ? ~0ull : ((1ull << (columns % 64)) - 1);
+    buffers[0].assign((size_t)rows * words, 0);
+    buffers[1].assign((size_t)rows * words, 0);
+}
+
+//Bitwise adders, each bit of the words is a different cell
+static inline void halfAdder(uint64_t a, uint64_t b, uint64_t &sum, uint64_t &carry)
+{
+    sum = a ^ b;
+    carry = a & b;
+}
+
+static inline void fullAdder(uint64_t a, uint64_t b, uint64_t c, uint64_t &sum, uint64_t &carry)
+{
+    uint64_t t = a ^ b;
+    sum = t ^ c;
+    carry = (a & b) | (t & c);
+}
+
+void BitPackedLife::sweep(int a, int b)
+{
+    const std::vector<uint64_t> &src = buffers[current_index];
+    std::vector<uint64_t> &dst = buffers[current_index ^ 1];
+    int last = words - 1;
+    int last_bit = (num_columns - 1) & 63;
+
+    for (int i = a; i < b; i++)
+    {
+        const uint64_t *rows[3] = {&src[(size_t)(i == 0 ? num_rows - 1 : i - 1) * words],
+                                   &src[(size_t)i * words],
+                                   &src[(size_t)(i == num_rows - 1 ? 0 : i + 1) * words]};
+        uint64_t *out = &dst[(size_t)i * words];
+
+        for (int w = 0; w < words; w++)
+        {
+            //West (column - 1) and east (column + 1) neighbours of every bit, following a toroidal behaviour
+            uint64_t west[3], centre[3], east[3];
+            for (int k = 0; k < 3; k++)
+            {
+                const uint64_t *r = rows[k];
+                uint64_t west_carry = (w == 0) ? (r[last] >> last_bit) & 1 : r[w - 1] >> 63;
+                uint64_t east_carry = (w == last) ? r[0] & 1 : r[w + 1] & 1;
+                centre[k] = r[w];
+                west[k] = (r[w] << 1) | west_carry;
+                east[k] = (r[w] >> 1) | (east_carry << (w == last ? last_bit : 63));
+            }
+
+            //Counting the 8 neighbours: count = b0 + 2 * b1 + 4 * b2 + 8 * b3
+            uint64_t s0, c0, s1, c1, s2, c2, b0, k0, t0, t1, b1, k1, b2, b3;
+            fullAdder(west[0], centre[0], east[0], s0, c0);
+            fullAdder(west[2], centre[2], east[2], s1, c1);
+            halfAdder(west[1], east[1], s2, c2);
+            fullAdder(s0, s1, s2, b0, k0);
+            fullAdder(c0, c1, c2, t0, t1);
+            halfAdder(t0, k0, b1, k1);
+            halfAdder(t1, k1, b2, b3);
+
+            //Applying the rule: for each count enabled in birth/survive select the matching cells
+            uint64_t alive = centre[1], next = 0;
+            for (int count = 0; count <= 8; count++)
+            {
+                bool born = (rule.birth >> count) & 1, survives = (rule.survive >> count) & 1;
+                if (!born && !survives)
+                    continue;
+                uint64_t match = ((count & 1) ? b0 : ~b0) & ((count & 2) ? b1 : ~b1) &
+                                 ((count & 4) ? b2 : ~b2) & ((count & 8) ? b3 : ~b3);
+                next |= match & ((born ? ~alive : 0) | (survives ? alive : 0));
+            }
+            out[w] = (w == last) ? next & last_mask : next;
+        }
+    }
+}
+
+void BitPackedLife::sequentialRun()
+{
+    utimer tseq("Bit-packed sequential time:");
+    for (int t = 0; t < timesteps; t++)
+    {
+        sweep(0, num_rows);
+        current_index ^= 1;
+    }
+}
+
+void BitPackedLife::threadsExecution()
+{
+    utimer tpar("Bit-packed thread execution time:");
+    if (!pool || pool->size() != num_threads)
+        pool = std::make_shared<WorkerPool>(num_threads);
+    int delta = num_rows / num_threads;
+    int exceeded = num_rows % num_threads;
+    pool->run([this, delta, exceeded](int id)
+              {
+                  //The first (num_rows % num_threads) threads get one more row
+                  int start = id * delta + std::min(id, exceeded);
+                  exec(start, start + delta + (id < exceeded ? 1 : 0));
+              });
+}
+
+void BitPackedLife::exec(int a, int b)
+{
+    for (int t = 0; t < timesteps; t++)
+    {
+        sweep(a, b);
+        //The last thread reaching the barrier makes the computed generation the current one
+        pool->sync([this]() { current_index ^= 1; });
+    }
+}
+
+void BitPackedLife::ompParallelFor()
+{
+    utimer my_timer("Bit-packed OpenMP parallel for time:");
+    for (int t = 0; t < timesteps; t++)
+    {
+#pragma omp parallel for num_threads(num_threads)
+        for (int i = 0; i < num_rows; i++)
+            sweep(i, i + 1);
+        current_index ^= 1;
+    }
+}
+
+int BitPackedLife::getCell(int i, int j) const
+{
+    return (buffers[current_index][(size_t)i * words + j / 64] >> (j % 64)) & 1;
+}
+
+grid2D BitPackedLife::getGrid() const
+{
+    grid2D copy(num_rows, std::vector<int>(num_columns));
+    for (int i = 0; i < num_rows; i++)
+        for (int j = 0; j < num_columns; j++)
+            copy[i][j] = getCell(i, j);
+    return copy;
+}
+
+void BitPackedLife::setGrid(const grid2D &new_grid)
+{
+    std::vector<uint64_t> &current = buffers[current_index];
+    std::fill(current.begin(), current.end(), 0);
+    for (int i = 0; i < num_rows; i++)
+        for (int j = 0; j < num_columns; j++)
+            if (new_grid[i][j] != 0)
+                current[(size_t)i * words + j / 64] |= 1ull << (j % 64);
+}
+
+void BitPackedLife::setGrid(const FlatGrid &new_grid)
+{
+    std::vector<uint64_t> &current = buffers[current_index];
+    std::fill(current.begin(), current.end(), 0);
+    for (int i = 0; i < num_rows; i++)
+    {
+        const int *cells = new_grid.row(i);
+        uint64_t *out = &current[(size_t)i * words];
+        for (int j = 0; j < num_columns; j++)
+            out[j / 64] |= (uint64_t)(cells[j] != 0) << (j % 64);
+    }
+}
+
+void BitPackedLife::copyTo(FlatGrid &destination) const
+{
+    for (int i = 0; i < num_rows; i++)
+    {
+        const uint64_t *in = &buffers[current_index][(size_t)i * words];
+        int *cells = destination.row(i);
+        for (int j = 0; j < num_columns; j++)
+            cells[j] = (in[j / 64] >> (j % 64)) & 1;
+    }
+}
+
+int BitPackedLife::getNumThreads() { return num_threads; }
+int BitPackedLife::getTimeSteps() { return timesteps; }
+void BitPackedLife::setNumThreads(int threads) { num_threads = threads; }
+void BitPackedLife::setWorkerPool(std::shared_ptr<WorkerPool> workers) { pool = workers; }
+std::shared_ptr<WorkerPool> BitPackedLife::getWorkerPool() { return pool; }
+void BitPackedLife::setTimeSteps(int tsteps) { timesteps = tsteps; }
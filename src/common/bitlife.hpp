@@ -0,0 +1,113 @@
+/**
+    @brief Bit-packed engine for 2-state life-like Cellular Automata.
+    64 cells are stored in each uint64_t and the 8 neighbours of a whole word are counted at once
+    with bitwise full adders, the birth/survive decision is then taken with bit masks.
+    Only rules where a cell is either dead (0) or alive (1) and the next state depends on the number
+    of living neighbours can be run here, e.g. gameOfLifeRule (B3/S23).
+    @file bitlife.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include "grid.hpp"
+#include "pool.hpp"
+#ifndef CA_BITLIFE_H
+#define CA_BITLIFE_H
+
+/**
+ Life-like rule, bit k of birth (survive) is set if a dead (living) cell with k living neighbours is alive in the next generation
+*/
+struct LifeLikeRule
+{
+    unsigned birth;
+    unsigned survive;
+};
+
+#define GAME_OF_LIFE_B3S23 (LifeLikeRule{1u << 3, (1u << 2) | (1u << 3)}) /**<Conway's Game of Life*/
+
+class BitPackedLife
+{
+private:
+    std::vector<uint64_t> buffers[2];         /**<Current and next generation, swapped at each timestep*/
+    int current_index = 0;                    /**<Index of the buffer holding the current generation*/
+    int num_rows, num_columns, num_threads;   /**<Grid and execution params*/
+    int words;                                /**<Number of words per row*/
+    int timesteps;                            /**<Number of epochs*/
+    uint64_t last_mask;                       /**<Mask of the valid bits of the last word of each row*/
+    LifeLikeRule rule;                        /**<Update rule*/
+    std::shared_ptr<WorkerPool> pool;         /**<Threads used by threadsExecution(), kept across runs*/
+
+    /**
+     Method computing the next state of the rows [a, b[ from the current buffer into the next one
+     @param a first row
+     @param b row after the last one
+    */
+    void sweep(int a, int b);
+
+    /**
+     Method executed by the pool's threads in the threadsExecution() method.
+     @param a starting point of the interval
+     @param b ending point of the interval
+    */
+    void exec(int a, int b);
+
+    /**
+     Method allocating the buffers, called by the constructors
+    */
+    void allocate(int rows, int columns, int tsteps, int numthreads, LifeLikeRule r);
+
+public:
+    /**
+      Constructor
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param tsteps number of generation executed
+      @param initial_state initial grid, every non zero cell is considered alive
+      @param numthreads number of threads for the execution
+      @param r life-like rule, Game of Life by default
+     */
+    BitPackedLife(int rows, int columns, int tsteps, const grid2D &initial_state, int numthreads, LifeLikeRule r = GAME_OF_LIFE_B3S23);
+
+    /**
+      Constructor starting from the flat grid of a CellularAutomata, see CellularAutomata::bitPackedRun()
+     */
+    BitPackedLife(int rows, int columns, int tsteps, const FlatGrid &initial_state, int numthreads, LifeLikeRule r = GAME_OF_LIFE_B3S23);
+
+    /**
+     Run methods, they follow the ones of CellularAutomata
+    */
+    void sequentialRun();
+    void threadsExecution();
+    void ompParallelFor();
+
+    /**
+     Method used to get the state of a cell
+     @param i row-index of the cell
+     @param j column-index of the cell
+     @returns 1 if the cell is alive, 0 otherwise
+    */
+    int getCell(int i, int j) const;
+
+    /**
+     Setter and Getter methods, the grid is converted from and to a std::vector<std::vector<int>>
+    */
+    grid2D getGrid() const;
+    void setGrid(const grid2D &new_grid);
+    void setGrid(const FlatGrid &new_grid);
+
+    /**
+     Method writing the current generation into a flat grid of the same size, as 0 and 1
+    */
+    void copyTo(FlatGrid &destination) const;
+    int getNumThreads();
+    int getTimeSteps();
+    void setNumThreads(int threads);
+    void setWorkerPool(std::shared_ptr<WorkerPool> workers);
+    std::shared_ptr<WorkerPool> getWorkerPool();
+    void setTimeSteps(int tsteps);
+};
+
+#endif
@@ -0,0 +1,729 @@
+#include "cellularautomata.hpp"
+#include "rules.hpp"
+
+/**
+    @brief Class and methods body of the cellularautomata.hpp file.
+    Here there's the pure body of the methods declared in the c++ header.
+    For more detail about what the function does, please, consult the cellularautomata.hpp file.
+    Here will be provided, where necessary, details about how the work it's done.
+    @file cellularAutomata.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+CellularAutomata::CellularAutomata(int rows, int columns, int (*function)(neighbourhood), int tsteps, int n_states, int numthreads)
+{
+    if (checkParameters(rows, columns, function, tsteps, numthreads) == false)
+        exit(-1);
+    states = n_states;
+    num_columns = columns;
+    num_rows = rows;
+    timesteps = tsteps;
+    rule = function;
+    num_threads = numthreads;
+
+    //Creation of the grid, current and next generation buffers. Each thread touches its band first, so that the
+    //pages are on its NUMA node, the random values don't move them
+    grid = placedGrid(rows, columns, num_threads, pinning, [](FlatGrid &current, int a, int b) { current.clearRows(a, b); });
+
+    //Random initialization
+    randomFill();
+}
+
+CellularAutomata::CellularAutomata(int rows, int columns, int (*function)(neighbourhood), int tsteps, const grid2D &initial_state, int numthreads)
+{
+    if (checkParameters(rows, columns, function, tsteps, numthreads) == false)
+        exit(-1);
+    num_columns = columns;
+    num_rows = rows;
+    timesteps = tsteps;
+    rule = function;
+    num_threads = numthreads;
+    states = countStates(initial_state);
+    setGrid(initial_state);
+}
+
+CellularAutomata::CellularAutomata(const std::string &grid_path, const std::string &next_path, int (*function)(neighbourhood), int tsteps, int n_states, int numthreads)
+{
+    FlatGrid current(grid_path);
+    if (checkParameters(current.getRows(), current.getColumns(), function, tsteps, numthreads) == false)
+        exit(-1);
+    states = n_states;
+    num_columns = current.getColumns();
+    num_rows = current.getRows();
+    timesteps = tsteps;
+    rule = function;
+    num_threads = numthreads;
+    FlatGrid next(next_path, num_rows, num_columns);
+    grid = PingPongGrid(std::move(current), std::move(next));
+}
+
+//PseudoRandomFill
+void CellularAutomata::randomFill()
+{
+    FlatGrid &current = grid.current();
+    for (int i = 0; i < num_rows; i++)
+        for (int j = 0; j < num_columns; j++)
+            current.at(i, j) = random_engine() % states;
+}
+
+//The run methods are templates defined in cellularautomata.hpp, here the classic rule is replaced by the fastest functor available
+void CellularAutomata::sequentialRun()
+{
+    withCompiledRule([this](const auto &r) { sequentialRun(r); });
+}
+
+void CellularAutomata::threadsExecution()
+{
+    withCompiledRule([this](const auto &r) { threadsExecution(r); });
+}
+
+void CellularAutomata::ompParallelFor()
+{
+    withCompiledRule([this](const auto &r) { ompParallelFor(r); });
+}
+
+void CellularAutomata::workStealingExecution()
+{
+    withCompiledRule([this](const auto &r) { workStealingExecution(r); });
+}
+
+void CellularAutomata::neighbourSyncExecution()
+{
+    withCompiledRule([this](const auto &r) { neighbourSyncExecution(r); });
+}
+
+void CellularAutomata::ompTaskWavefront()
+{
+    withCompiledRule([this](const auto &r) { ompTaskWavefront(r); });
+}
+
+void CellularAutomata::ompTemporalBlocking()
+{
+    withCompiledRule([this](const auto &r) { ompTemporalBlocking(r); });
+}
+
+void CellularAutomata::outOfCoreRun()
+{
+    withCompiledRule([this](const auto &r) { outOfCoreRun(r); });
+}
+
+void CellularAutomata::fastFlowParallelFor()
+{
+    withCompiledRule([this](const auto &r) { fastFlowParallelFor(r); });
+}
+
+void CellularAutomata::bitPackedRun()
+{
+    OuterTotalisticRule totalistic;
+    if (!totalisticEquivalent(rule, states, &totalistic) || totalistic.states != 2)
+    {
+        ompParallelFor();
+        return;
+    }
+    //The grid is overwritten at the end, so a shadow snapshot has to be written first
+    settleSnapshots();
+    BitPackedLife life(num_rows, num_columns, timesteps, grid.current(), num_threads, LifeLikeRule{totalistic.birth, totalistic.survive});
+    if (num_threads > 1)
+    {
+        workerPool();
+        life.setWorkerPool(pool);
+        life.threadsExecution();
+    }
+    else
+        life.sequentialRun();
+    life.copyTo(grid.current());
+    endGenerations(timesteps);
+}
+
+std::map<std::string, ExecutorFactory> &CellularAutomata::executorRegistry()
+{
+    //Built on first use, so that it's there before any executor is registered or run
+    static std::map<std::string, ExecutorFactory> registry = []
+    {
+        std::map<std::string, ExecutorFactory> builtin;
+        auto method = [&builtin](const std::string &name, std::function<void(CellularAutomata &)> body)
+        {
+            builtin[name] = [body] { return std::make_unique<MethodExecutor>(body); };
+        };
+        method("seq", [](CellularAutomata &ca) { ca.sequentialRun(); });
+        method("threads", [](CellularAutomata &ca) { ca.threadsExecution(); });
+        method("omp", [](CellularAutomata &ca) { ca.ompParallelFor(); });
+        method("steal", [](CellularAutomata &ca) { ca.workStealingExecution(); });
+        method("nsync", [](CellularAutomata &ca) { ca.neighbourSyncExecution(); });
+        method("wavefront", [](CellularAutomata &ca) { ca.ompTaskWavefront(); });
+        method("temporal", [](CellularAutomata &ca) { ca.ompTemporalBlocking(); });
+        method("ooc", [](CellularAutomata &ca) { ca.outOfCoreRun(); });
+        method("ffpf", [](CellularAutomata &ca) { ca.fastFlowParallelFor(); });
+        method("farm", [](CellularAutomata &ca) { ca.startFarm(); });
+        method("bitlife", [](CellularAutomata &ca) { ca.bitPackedRun(); });
+        return builtin;
+    }();
+    return registry;
+}
+
+void CellularAutomata::registerExecutor(const std::string &name, ExecutorFactory factory)
+{
+    if (name.empty() || !factory)
+    {
+        std::cerr << "Error: an executor needs a name and a factory" << std::endl;
+        exit(-1);
+    }
+    executorRegistry()[name] = std::move(factory);
+}
+
+std::vector<std::string> CellularAutomata::getExecutors()
+{
+    std::vector<std::string> names;
+    for (const auto &entry : executorRegistry())
+        names.push_back(entry.first);
+    return names;
+}
+
+void CellularAutomata::run(const std::string &name)
+{
+    auto it = executors.find(name);
+    if (it == executors.end())
+    {
+        auto factory = executorRegistry().find(name);
+        if (factory == executorRegistry().end())
+        {
+            std::cerr << "Error: unknown executor " << name << std::endl;
+            exit(-1);
+        }
+        it = executors.emplace(name, factory->second()).first;
+    }
+    it->second->run(*this);
+}
+
+int CellularAutomata::beginRun()
+{
+    settleSnapshots();
+    if (!tiles.enabled())
+        return num_rows;
+    tiles.reset();
+    return tiles.getTileRows();
+}
+
+void CellularAutomata::endStep()
+{
+    if (tiles.enabled())
+        tiles.endStep();
+    grid.swap();
+    endGenerations(1);
+}
+
+void CellularAutomata::endGenerations(int steps)
+{
+    generation += steps;
+    if (!snapshots)
+        return;
+    //In shadow mode the buffer of the last frame is about to be overwritten, the skipped tiles would keep the cells of the spare
+    if (snapshots->retire(grid.next()) && tiles.enabled())
+        tiles.invalidate();
+    if (snapshots->due(generation, steps))
+        snapshots->capture(grid.current(), generation);
+}
+
+void CellularAutomata::settleSnapshots()
+{
+    if (snapshots)
+        snapshots->settle();
+}
+
+void CellularAutomata::setActiveTiles(int tile_rows, int tile_columns)
+{
+    tiles.configure(num_rows, num_columns, tile_rows, tile_columns);
+}
+
+std::vector<double> CellularAutomata::getActiveTileFractions() { return tiles.getActiveFractions(); }
+
+WorkerPool &CellularAutomata::workerPool()
+{
+    if (!pool || pool->size() != num_threads || pool->isPinned() != pinning)
+        pool = std::make_shared<WorkerPool>(num_threads, pinning);
+    return *pool;
+}
+
+void CellularAutomata::placeGrid()
+{
+    settleSnapshots();
+    //The pages of a mapped grid belong to its files
+    if (grid.current().isMapped())
+        return;
+    PingPongGrid old = std::move(grid);
+    const FlatGrid &source = old.current();
+    grid = placedGrid(num_rows, num_columns, num_threads, pinning, [&source](FlatGrid &current, int a, int b)
+                      {
+                          if (b > a)
+                              std::memcpy(current.row(a), source.row(a), sizeof(int) * (size_t)(b - a) * current.getStride());
+                      });
+}
+
+void CellularAutomata::pinOmpThreads()
+{
+    if (!pinning && !omp_pinned)
+        return;
+    const ThreadPlacement &placement = ThreadPlacement::topology();
+    bool pin = pinning;
+#pragma omp parallel num_threads(num_threads)
+    {
+        if (pin)
+            placement.pin(omp_get_thread_num(), omp_get_num_threads());
+        else
+            placement.unpin();
+    }
+    omp_pinned = pinning;
+}
+
+void CellularAutomata::setThreadPinning(bool pin)
+{
+    pinning = pin;
+    placeGrid();
+}
+
+bool CellularAutomata::getThreadPinning() { return pinning; }
+
+std::string CellularAutomata::topologyReport()
+{
+    return ThreadPlacement::topology().report(num_threads, pinning, &grid.current());
+}
+
+void CellularAutomata::setSnapshots(const std::string &path, int interval, bool compress, bool shadow)
+{
+    //The previous writer, if any, is closed first
+    snapshots.reset();
+    snapshots = std::make_unique<SnapshotWriter>(path, num_rows, num_columns, states, interval, compress);
+    if (shadow)
+    {
+        if (grid.current().isMapped())
+        {
+            std::cerr << "Error: the shadow snapshots need a grid in memory" << std::endl;
+            exit(-1);
+        }
+        //The spare buffer is placed like the grid
+        PingPongGrid spare = placedGrid(num_rows, num_columns, num_threads, pinning, [](FlatGrid &current, int a, int b) { current.clearRows(a, b); });
+        snapshots->shadowBuffer(std::move(spare.current()));
+    }
+}
+
+void CellularAutomata::stopSnapshots() { snapshots.reset(); }
+const SnapshotWriter *CellularAutomata::getSnapshotWriter() { return snapshots.get(); }
+
+void CellularAutomata::setOutOfCore(const std::string &grid_path, const std::string &next_path)
+{
+    settleSnapshots();
+    FlatGrid current(grid_path, num_rows, num_columns), next(next_path, num_rows, num_columns);
+    const FlatGrid &source = grid.current();
+    for (int i = 0; i < num_rows; i++)
+        std::memcpy(current.row(i), source.row(i), sizeof(int) * current.getStride());
+    grid = PingPongGrid(std::move(current), std::move(next));
+}
+
+void CellularAutomata::saveCheckpoint(const std::string &path)
+{
+    CheckpointState state;
+    state.rows = num_rows;
+    state.columns = num_columns;
+    state.states = states;
+    state.generation = generation;
+    state.rule_id = ruleId(rule, states);
+    std::ostringstream random;
+    random << random_engine;
+    state.random = random.str();
+    ::saveCheckpoint(path, grid.current(), state, num_threads);
+}
+
+void CellularAutomata::loadCheckpoint(const std::string &path)
+{
+    settleSnapshots();
+    CheckpointFile file(path);
+    const CheckpointState &state = file.getState();
+    if (state.rule_id != ruleId(rule, state.states))
+    {
+        std::cerr << "Error: the checkpoint was saved with a different rule" << std::endl;
+        exit(-1);
+    }
+    //A grid of the same size, or a mapped one, is overwritten in place
+    if (!grid.current().isMapped() && (state.rows != num_rows || state.columns != num_columns))
+    {
+        setRows(state.rows);
+        setColumns(state.columns);
+        //The chunks are decoded in place, after the threads touched their bands
+        grid = placedGrid(num_rows, num_columns, num_threads, pinning, [](FlatGrid &current, int a, int b) { current.clearRows(a, b); });
+        tiles.resize(num_rows, num_columns);
+    }
+    file.load(grid.current(), num_threads);
+    states = state.states;
+    generation = state.generation;
+    std::istringstream random(state.random);
+    random >> random_engine;
+}
+
+long CellularAutomata::getGeneration() { return generation; }
+const Tracer &CellularAutomata::getTracer() { return tracer; }
+
+void CellularAutomata::setWorkerPool(std::shared_ptr<WorkerPool> workers) { pool = workers; }
+std::shared_ptr<WorkerPool> CellularAutomata::getWorkerPool() { return pool; }
+
+void CellularAutomata::setStealingTiles(int tile_rows, int tile_columns)
+{
+    if (tile_rows <= 0 || tile_columns <= 0)
+    {
+        std::cerr << "Error: the tile size must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    stealing_tile_rows = tile_rows;
+    stealing_tile_columns = tile_columns;
+}
+
+std::vector<WorkerStats> CellularAutomata::getWorkerStats() { return scheduler.getStats(); }
+
+void CellularAutomata::setWavefrontTiles(int tile_rows, int tile_columns)
+{
+    if (tile_rows <= 0 || tile_columns <= 0)
+    {
+        std::cerr << "Error: the tile size must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    wavefront_tile_rows = tile_rows;
+    wavefront_tile_columns = tile_columns;
+}
+
+void CellularAutomata::setFarmTiles(int tile_rows, int tile_columns)
+{
+    if (tile_rows <= 0 || tile_columns <= 0)
+    {
+        std::cerr << "Error: the tile size must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    farm_tile_rows = tile_rows;
+    farm_tile_columns = tile_columns;
+}
+
+void CellularAutomata::setParallelForGrain(int grain)
+{
+    if (grain <= 0)
+    {
+        std::cerr << "Error: the parallel for grain must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    parallel_for_grain = grain;
+}
+
+void CellularAutomata::applyConfig(const TunedConfig &config)
+{
+    if (config.threads != num_threads)
+        setNumThreads(config.threads);
+    if (config.tile_rows > 0 && config.tile_columns > 0)
+    {
+        if (config.backend == "steal")
+            setStealingTiles(config.tile_rows, config.tile_columns);
+        else if (config.backend == "wavefront")
+            setWavefrontTiles(config.tile_rows, config.tile_columns);
+        else if (config.backend == "temporal")
+            setTemporalBlocking(temporal_depth, config.tile_rows, config.tile_columns);
+        else if (config.backend == "farm")
+            setFarmTiles(config.tile_rows, config.tile_columns);
+    }
+    setParallelForGrain(config.grain);
+}
+
+//Stream buffer dropping everything, the run methods print their utimer
+struct NullBuffer : std::streambuf
+{
+    int overflow(int c) override { return c; }
+};
+
+double CellularAutomata::timeTrial(const TunedConfig &config, const grid2D &initial)
+{
+    applyConfig(config);
+    NullBuffer null;
+    double best = 0;
+    for (int i = 0; i < TUNE_REPETITIONS; i++)
+    {
+        setGrid(initial);
+        std::streambuf *out = std::cout.rdbuf(&null);
+        auto start = std::chrono::steady_clock::now();
+        run(config.backend);
+        auto stop = std::chrono::steady_clock::now();
+        std::cout.rdbuf(out);
+        best = std::max(best, (double)num_rows * num_columns * timesteps / std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+TunedConfig CellularAutomata::autotune(const std::string &cache_path, int trial_steps, bool retune)
+{
+    if (trial_steps <= 0)
+    {
+        std::cerr << "Error: the trial steps must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    TunedConfig best;
+    std::string key = tuneKey(num_rows, num_columns, ruleId(rule, states), states);
+    if (!retune && loadTunedConfig(cache_path, key, best))
+    {
+        applyConfig(best);
+        return best;
+    }
+    if (grid.current().isMapped())
+    {
+        std::cerr << "Error: the autotuner needs a grid in memory" << std::endl;
+        exit(-1);
+    }
+
+    //The trials run on a copy of the grid, without snapshots and with their own number of steps
+    settleSnapshots();
+    grid2D initial = copyGrid();
+    long saved_generation = generation;
+    int saved_timesteps = timesteps;
+    std::unique_ptr<SnapshotWriter> saved_snapshots = std::move(snapshots);
+    timesteps = trial_steps;
+
+    std::vector<int> thread_counts;
+    int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (int t = 1; t < hardware; t *= 2)
+        thread_counts.push_back(t);
+    thread_counts.push_back(hardware);
+
+    //First pass: backends and thread counts with the current tile sizes
+    OuterTotalisticRule totalistic;
+    bool life_like = totalisticEquivalent(rule, states, &totalistic) && totalistic.states == 2;
+    for (const std::string backend : {"seq", "threads", "omp", "steal", "nsync", "wavefront", "temporal", "ffpf", "farm", "bitlife"})
+        for (int threads : thread_counts)
+        {
+            //The sequential run ignores the thread count, the bit-packed one would only repeat omp with the other rules
+            if ((backend == "seq" && threads > 1) || (backend == "bitlife" && !life_like))
+                break;
+            TunedConfig trial;
+            trial.backend = backend;
+            trial.threads = threads;
+            trial.grain = parallel_for_grain;
+            trial.cells_per_second = timeTrial(trial, initial);
+            if (trial.cells_per_second > best.cells_per_second)
+                best = trial;
+        }
+
+    //Second pass: tile shapes, or the grain, of the fastest backend
+    std::vector<std::pair<int, int>> shapes = {{16, 512}, {32, 256}, {64, 128}, {128, 1024}, {256, 256}};
+    if (best.backend == "steal" || best.backend == "wavefront" || best.backend == "temporal" || best.backend == "farm")
+    {
+        //The current shape is recorded, so that it's restored when it stays the fastest
+        if (best.backend == "steal")
+            best.tile_rows = stealing_tile_rows, best.tile_columns = stealing_tile_columns;
+        else if (best.backend == "wavefront")
+            best.tile_rows = wavefront_tile_rows, best.tile_columns = wavefront_tile_columns;
+        else if (best.backend == "temporal")
+            best.tile_rows = temporal_tile_rows, best.tile_columns = temporal_tile_columns;
+        else
+            best.tile_rows = farm_tile_rows, best.tile_columns = farm_tile_columns;
+        for (const auto &shape : shapes)
+        {
+            TunedConfig trial = best;
+            trial.tile_rows = std::min(shape.first, num_rows);
+            trial.tile_columns = std::min(shape.second, num_columns);
+            trial.cells_per_second = timeTrial(trial, initial);
+            if (trial.cells_per_second > best.cells_per_second)
+                best = trial;
+        }
+    }
+    else if (best.backend == "ffpf")
+        for (int grain : {1, 2, 4, 8, 16, 64})
+        {
+            TunedConfig trial = best;
+            trial.grain = grain;
+            trial.cells_per_second = timeTrial(trial, initial);
+            if (trial.cells_per_second > best.cells_per_second)
+                best = trial;
+        }
+
+    timesteps = saved_timesteps;
+    snapshots = std::move(saved_snapshots);
+    applyConfig(best);
+    setGrid(initial);
+    generation = saved_generation;
+    saveTunedConfig(cache_path, key, best);
+    return best;
+}
+
+void CellularAutomata::setTemporalBlocking(int depth, int tile_rows, int tile_columns)
+{
+    if (depth <= 0 || tile_rows <= 0 || tile_columns <= 0)
+    {
+        std::cerr << "Error: temporal blocking depth and tile size must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    temporal_depth = depth;
+    temporal_tile_rows = tile_rows;
+    temporal_tile_columns = tile_columns;
+}
+
+std::vector<int> CellularAutomata::getNeighbourhood(int x, int y, const FlatGrid *grid_)
+{
+    std::vector<int> neighbourhood;
+    int i = 0;
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(x, y));                        //Actual state
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(upperRow(x), leftColumn(y)));  //upper left cell
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(upperRow(x), y));              //upper cell
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(upperRow(x), rightColumn(y))); //upper right cell
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(x, leftColumn(y)));            //left cell
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(x, rightColumn(y)));           // right cell
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(lowerRow(x), leftColumn(y)));  // lower left cell
+    neighbourhood.insert(neighbourhood.begin() + i++, grid_->at(lowerRow(x), y));              //lower cell
+    neighbourhood.insert(neighbourhood.begin() + i, grid_->at(lowerRow(x), rightColumn(y)));
+    return neighbourhood;
+}
+
+std::vector<int> CellularAutomata::getNeighbourhood(int x, int y, const FlatGrid *grid_, const Neighbourhood &shape)
+{
+    std::vector<int> neighbourhood = {grid_->at(x, y)};
+    //The offsets may be larger than the grid, they wrap around as many times as needed
+    for (const std::pair<int, int> &offset : shape.offsets())
+        neighbourhood.push_back(grid_->at(((x + offset.first) % num_rows + num_rows) % num_rows, ((y + offset.second) % num_columns + num_columns) % num_columns));
+    return neighbourhood;
+}
+
+grid2D CellularAutomata::copyGrid()
+{
+    return grid.current().toGrid2D();
+}
+
+void CellularAutomata::printMatrix()
+{
+
+    const FlatGrid &current = grid.current();
+    for (int i = 0; i < num_rows; i++)
+    {
+        for (int j = 0; j < num_columns; j++)
+            std::cout << current.at(i, j) << '\t';
+        std::cout << '\n';
+    }
+    std::cout << "\n \n \n";
+    std::cout << "°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°°" << std::endl;
+}
+
+int CellularAutomata::upperRow(int index)
+{
+    if (index == 0)
+        return num_rows - 1;
+    else
+        return index - 1;
+}
+
+int CellularAutomata::lowerRow(int index)
+{
+    if (index == (num_rows - 1))
+    {
+        return 0;
+    }
+    else
+        return index + 1;
+}
+
+int CellularAutomata::rightColumn(int index)
+{
+    if (index == (num_columns - 1))
+        return 0;
+    else
+        return index + 1;
+}
+
+int CellularAutomata::leftColumn(int index)
+{
+    if (index == 0)
+    {
+        return num_columns - 1;
+    }
+    else
+        return index - 1;
+}
+
+grid2D CellularAutomata::getGrid() { return grid.current().toGrid2D(); }
+
+void CellularAutomata::restartGrid()
+{
+    settleSnapshots();
+    generation = 0;
+    randomFill();
+}
+
+int CellularAutomata::countStates(const grid2D &grid_)
+{
+    int max_state = 1;
+    for (const std::vector<int> &row : grid_)
+        for (int cell : row)
+            max_state = std::max(max_state, cell);
+    return max_state + 1;
+}
+
+bool CellularAutomata::checkParameters(int rows, int columns, int (*function)(neighbourhood), int tsteps, int numthreads)
+{
+    bool flag = true;
+
+    if (rows <= 0 || columns <= 0)
+    {
+        std::cerr << "Error: rows or columns value wasn't valid" << std::endl;
+        flag = false;
+    }
+
+    if (tsteps <= 0)
+    {
+        std::cerr << "Error: timesteps values wasn't strictly positive" << std::endl;
+        flag = false;
+    }
+
+    if (numthreads <= 0)
+    {
+        std::cerr << "Error: the number of threads wasn't strictly positive" << std::endl;
+        flag = false;
+    }
+    if (function == nullptr)
+    {
+        std::cerr << "Error: rule provided wasn't valid" << std::endl;
+        flag = false;
+    }
+    return flag;
+
+    
+}
+
+int CellularAutomata::getNumThreads(){return num_threads;}
+int CellularAutomata::getColumns(){return num_columns;}
+int CellularAutomata::getRows(){return num_rows;}
+int CellularAutomata::getTimeSteps(){return timesteps;}
+void CellularAutomata::setNumThreads(int threads){num_threads=threads; placeGrid();}
+void CellularAutomata::setColumns(int columns){num_columns=columns;}
+void CellularAutomata::setRows(int rows){num_rows=rows;}
+void CellularAutomata::setGrid(const grid2D &new_grid)
+{
+    settleSnapshots();
+    if (grid.current().isMapped())
+    {
+        //The files keep their size, the grid is copied into the current one
+        if ((int)new_grid.size() != num_rows || (int)new_grid[0].size() != num_columns)
+        {
+            std::cerr << "Error: the grid doesn't match the size of the out-of-core files" << std::endl;
+            exit(-1);
+        }
+        grid.current().fromGrid2D(new_grid);
+        states = std::max(states, countStates(new_grid));
+        generation = 0;
+        return;
+    }
+    setRows(new_grid.size());
+    setColumns(new_grid[0].size());
+    //Each thread copies its band, so that the pages are on its NUMA node
+    grid = placedGrid(num_rows, num_columns, num_threads, pinning, [&new_grid](FlatGrid &current, int a, int b)
+                      {
+                          current.clearRows(a, b);
+                          for (int i = a; i < b; i++)
+                              std::memcpy(current.row(i), new_grid[i].data(), sizeof(int) * new_grid[i].size());
+                      });
+    states = std::max(states, countStates(new_grid));
+    tiles.resize(num_rows, num_columns);
+    generation = 0;
+}
+void CellularAutomata::setRule(int(*func)(neighbourhood)){rule=func;}
+
+// Integer Functions to get positions and fill the matrix
@@ -0,0 +1,1171 @@
+/**
+    @brief Class and methods for Cellular automata computation.
+    The same engine holds the grid, the compiled rules, the active tiles, the snapshots and the checkpoints, and runs the
+    timesteps with any of its executors: sequential, c++ Threads, OpenMP, FastFlow parallel for and FastFlow farm, plus
+    the variants of them (work stealing, neighbour synchronization, task wavefront, temporal blocking, out-of-core).
+    Each executor is a run method, which can also be chosen by name at run time through run() (see executor.hpp).
+    @file cellularAutomata.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <map>
+#include "utimer.cpp"
+#include <omp.h>
+#include <ff/ff.hpp>
+#include <ff/farm.hpp>
+#include <ff/parallel_for.hpp>
+#include "grid.hpp"
+#include "stencil.hpp"
+#include "totalistic.hpp"
+#include "lut.hpp"
+#include "tiles.hpp"
+#include "temporal.hpp"
+#include "numa.hpp"
+#include "pool.hpp"
+#include "stealing.hpp"
+#include "bitlife.hpp"
+#include "snapshot.hpp"
+#include "checkpoint.hpp"
+#include "trace.hpp"
+#include "executor.hpp"
+#include "autotune.hpp"
+#include "neighbourhood.hpp"
+#include "rules.hpp"
+#ifndef CELLULAR_AUTOMATA_H
+#define CELLULAR_AUTOMATA_H
+
+#define DEFAULT_WAVEFRONT_TILE_ROWS 64     /**<Default tile rows of ompTaskWavefront()*/
+#define DEFAULT_WAVEFRONT_TILE_COLUMNS 256 /**<Default tile columns of ompTaskWavefront()*/
+#define OUT_OF_CORE_BAND_BYTES (64 << 20)  /**<Bytes of both generations kept in memory by outOfCoreRun()*/
+#define DEFAULT_FARM_TILE_ROWS 32          /**<Default tile rows of the farm*/
+#define DEFAULT_FARM_TILE_COLUMNS 256      /**<Default tile columns of the farm*/
+#define DEFAULT_PARALLEL_FOR_GRAIN 1       /**<Default bands per task of the FastFlow parallel for*/
+
+//Defining aliases
+using neighbourhood = std::vector<int>;
+using grid2D = std::vector<std::vector<int>>;
+using namespace ff;
+
+class CellularAutomata
+{
+    //Task of the farm: a tile and the generation it has to be computed from. There's one per tile,
+    //the workers send it back as result and the emitter sends it out again, so the farm never allocates
+    struct TILE
+    {
+        int index;             /**<Index of the tile, row by row*/
+        int tile_row;          /**<Row-index of the tile*/
+        int tile_column;       /**<Column-index of the tile*/
+        int generation;        /**<Generation the tile is computed from*/
+    };
+
+private:
+    PingPongGrid grid;                    /**<Current and next generation of the grid, swapped at each timestep*/
+    int num_rows, num_columns, states, num_threads;    /**<Cellular Automata params*/
+    int (*rule)(neighbourhood) = nullptr; /**<Cellular Automata update rule*/
+    int timesteps;                        /**<Number of epochs*/
+    RuleTable table;                      /**<Lookup table compiled from the rule, when it has few states*/
+    ActiveTiles tiles;                    /**<Active-tile tracking, disabled by default*/
+    int temporal_depth = DEFAULT_TEMPORAL_DEPTH;                                            /**<Generations per pass of ompTemporalBlocking()*/
+    std::shared_ptr<WorkerPool> pool;     /**<Threads used by threadsExecution(), kept across runs*/
+    StealingScheduler scheduler;          /**<Scheduler of workStealingExecution()*/
+    int stealing_tile_rows = DEFAULT_STEALING_TILE_ROWS, stealing_tile_columns = DEFAULT_STEALING_TILE_COLUMNS; /**<Tile size of workStealingExecution()*/
+    int wavefront_tile_rows = DEFAULT_WAVEFRONT_TILE_ROWS, wavefront_tile_columns = DEFAULT_WAVEFRONT_TILE_COLUMNS; /**<Tile size of ompTaskWavefront()*/
+    int temporal_tile_rows = DEFAULT_TEMPORAL_TILE_ROWS, temporal_tile_columns = DEFAULT_TEMPORAL_TILE_COLUMNS; /**<Tile size of ompTemporalBlocking()*/
+    int farm_tile_rows = DEFAULT_FARM_TILE_ROWS, farm_tile_columns = DEFAULT_FARM_TILE_COLUMNS; /**<Tile size of the farm*/
+    FlatGrid *farm_buffers[2];            /**<Buffers of the farm, generation g is read from farm_buffers[g % 2]*/
+    int parallel_for_grain = DEFAULT_PARALLEL_FOR_GRAIN; /**<Bands per task of fastFlowParallelFor()*/
+    bool pinning = false;                 /**<Whether the threads are pinned to CPUs (see numa.hpp)*/
+    bool omp_pinned = false;              /**<Whether the OpenMP threads are currently pinned*/
+    std::unique_ptr<SnapshotWriter> snapshots; /**<Asynchronous writer of the snapshots, nullptr when disabled*/
+    long generation = 0;                  /**<Generations computed from the current grid*/
+    std::mt19937 random_engine{std::random_device{}()}; /**<Generator of randomFill(), saved by the checkpoints*/
+    Tracer tracer;                        /**<Per-thread trace of the last run, recorded only with CA_TRACE*/
+    std::map<std::string, std::unique_ptr<Executor>> executors; /**<Executors created by run(), kept across runs*/
+
+    /**
+     The run methods split the work in bands: rows, or tile-rows when the active-tile tracking is enabled.
+     beginRun() resets the tile flags and returns the number of bands, sweepBand() computes the bands [a, b[
+     and endStep() closes a timestep.
+    */
+    int beginRun();
+    template <typename Rule>
+    void sweepBand(int a, int b, const Rule &r);
+    void endStep();
+
+    /**
+     Method computing a tile of the farm, generation + 1 is computed from generation
+    */
+    template <typename Rule>
+    void sweepTile(const TILE &task, const Rule &r);
+
+    /**
+     Registry of the executors by name, filled with the built-in ones on first use
+    */
+    static std::map<std::string, ExecutorFactory> &executorRegistry();
+
+    /**
+     Method timing a trial of autotune(): the grid is reset to initial before each run, the fastest run counts
+     @returns cells per second
+    */
+    double timeTrial(const TunedConfig &config, const grid2D &initial);
+
+    /**
+     Method counting steps more generations and handing the current one to the snapshot writer when a frame is due.
+     endStep() calls it, the run methods without a global step boundary call it at their end with all the steps
+    */
+    void endGenerations(int steps);
+
+    /**
+     Method waiting until the buffer of the last shadow snapshot can be written (see SnapshotWriter::settle()), called
+     before the grid is modified outside the step by step runs
+    */
+    void settleSnapshots();
+
+    /**
+     Method returning the worker pool, it's (re)created when missing or when its size or pinning differ from the automaton's
+    */
+    WorkerPool &workerPool();
+
+    /**
+     Method moving the grid to buffers first touched by the threads, each one writing the band of rows it computes (see numa.hpp)
+    */
+    void placeGrid();
+
+    /**
+     Method pinning the OpenMP threads, or unpinning them if the pinning was disabled, called at the beginning of the OpenMP runs
+    */
+    void pinOmpThreads();
+
+    /**
+     Method calling body with the fastest functor equivalent to the rule pointer: the vectorized kernel for the
+     outer-totalistic rules, a lookup table for the other small-state rules, FunctionRule otherwise.
+     @param body generic callable receiving the rule functor
+    */
+    template <typename Body>
+    void withCompiledRule(const Body &body);
+
+public:
+    /** 
+      Default constructor
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param function rule to use in order to compute grid's next state
+      @param tsteps number of generation executed
+      @param random_init if true, the grid is randomly initialized
+      @param numthreads number of threads for the execution
+     */
+    CellularAutomata(int rows, int columns, int (*function)(neighbourhood), int tsteps, int n_states, int numthreads);
+
+    /** 
+      Alternative constructor
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param function rule to use in order to compute grid's next state
+      @param tsteps number of generation executed
+      @param initial_state provide an existing grid instead of creating a new, random, one
+      @param numthreads number of threads for the execution
+     */
+    CellularAutomata(int rows, int columns, int (*function)(neighbourhood), int tsteps, const grid2D &initial_state, int numthreads);
+
+    /**
+      Out-of-core constructor: the initial state is a grid file mapped in place, without a heap copy (see grid.hpp),
+      and the next generation is a second file of the same size. Both files hold the generations during the runs
+      @param grid_path existing grid file with the initial state, a FlatGrid(path, rows, columns) can write it
+      @param next_path file created for the next generation
+      @param function rule to use in order to compute grid's next state
+      @param tsteps number of generation executed
+      @param n_states number of states of the grid
+      @param numthreads number of threads for the execution
+     */
+    CellularAutomata(const std::string &grid_path, const std::string &next_path, int (*function)(neighbourhood), int tsteps, int n_states, int numthreads);
+
+    /**
+     Method executing the sequential version of the CellularAutomata a single thread goes cell by cell updating the states
+    */
+    void sequentialRun();
+
+    /**
+     Method implementing the Thread execution of the Cellular Automata. it used the num_threads initialized at the construction.
+     The threads belong to a pool which is kept across runs (see pool.hpp)
+    */
+    void threadsExecution();
+
+    /**
+     Method implementing a Thread execution of the Cellular Automata using OpenMP Parallel For
+    */
+    void ompParallelFor();
+
+    /**
+     Method implementing a Thread execution where the grid is split in 2D tiles scheduled by work-stealing deques
+     (see stealing.hpp), useful when the cost of the tiles varies. The threads come from the same pool of threadsExecution().
+     With the active-tile tracking enabled the tiles are the tracked ones.
+    */
+    void workStealingExecution();
+
+    /**
+     Method implementing a Thread execution without global barriers: each thread owns a band of rows and publishes
+     the generation reached by its boundary rows, then waits only for the two neighbouring bands (see neighbourExec()).
+     Fast bands can run one generation ahead of their neighbours. The active-tile tracking isn't used by this method.
+    */
+    void neighbourSyncExecution();
+
+    /**
+     Method implementing an OpenMP execution where every (tile, generation) pair is a task depending on the 3x3 tiles
+     around it at the previous generation: the runtime pipelines the generations over the grid without global barriers.
+     The active-tile tracking isn't used by this method.
+    */
+    void ompTaskWavefront();
+
+    /**
+     Method implementing a temporally blocked execution using OpenMP: each thread loads a tile plus a halo,
+     advances it several generations in cache and writes back the interior (see temporal.hpp).
+     It's meant for large grids, where ompParallelFor() is limited by the memory bandwidth.
+     The active-tile tracking isn't used by this method.
+    */
+    void ompTemporalBlocking();
+
+    /**
+     Method executing the simulation on grids larger than the memory. Each generation is swept in bands of rows, in order,
+     whose pages are read ahead while the previous band is computed and dropped once it's done (madvise hints), so only
+     a few bands of the mapped files are resident. The rows of a band are computed by the OpenMP threads.
+     The grids are mapped by the out-of-core constructor or setOutOfCore(), the heap grids just don't get the hints.
+    */
+    void outOfCoreRun();
+
+    /**
+     Method which runs the Cellular Automata simulation using FastFlow's parallel for.
+    */
+    void fastFlowParallelFor();
+
+    /**
+     Method running the timesteps on BitPackedLife (see bitlife.hpp), 64 cells per word, with the threads of threadsExecution().
+     It's used when the rule is a 2-state life-like rule (see totalisticEquivalent()), e.g. gameOfLifeRule with 2 states,
+     the grid is packed before the run and unpacked after it. The other rules are run by ompParallelFor().
+     The active-tile tracking isn't used by this method and the snapshot of the last generation is the only one taken.
+    */
+    void bitPackedRun();
+
+    /**
+     Templated versions of the run methods above. The rule is a functor type (see stencil.hpp and rules.hpp)
+     which is inlined in the sweep instead of being called through the rule pointer.
+     @param r rule used to compute the next state of each cell
+    */
+    template <typename Rule>
+    void sequentialRun(const Rule &r);
+    template <typename Rule>
+    void threadsExecution(const Rule &r);
+    template <typename Rule>
+    void ompParallelFor(const Rule &r);
+    template <typename Rule>
+    void ompTemporalBlocking(const Rule &r);
+    template <typename Rule>
+    void outOfCoreRun(const Rule &r);
+    template <typename Rule>
+    void workStealingExecution(const Rule &r);
+    template <typename Rule>
+    void neighbourSyncExecution(const Rule &r);
+    template <typename Rule>
+    void ompTaskWavefront(const Rule &r);
+    template <typename Rule>
+    void fastFlowParallelFor(const Rule &r);
+
+    /**
+     Method running the timesteps with the executor registered as name. The built-in ones are seq (sequentialRun()),
+     threads (threadsExecution()), omp (ompParallelFor()), steal (workStealingExecution()), nsync (neighbourSyncExecution()),
+     wavefront (ompTaskWavefront()), temporal (ompTemporalBlocking()), ooc (outOfCoreRun()), ffpf (fastFlowParallelFor()),
+     farm (startFarm()) and bitlife (bitPackedRun())
+     @param name executor, see getExecutors()
+    */
+    void run(const std::string &name);
+
+    /**
+     Method adding an executor, or replacing the one with the same name, for all the automata
+     @param name name given to run()
+     @param factory creates the executor, once for each automaton running it
+    */
+    static void registerExecutor(const std::string &name, ExecutorFactory factory);
+
+    /**
+     Method returning the names of the registered executors
+    */
+    static std::vector<std::string> getExecutors();
+
+    /**
+     Method executed by the pool's threads in the neighbourSyncExecution() method.
+     To compute generation t + 1 a band needs the boundary rows of generation t of its neighbours, and it overwrites
+     the buffer holding generation t - 1, whose boundary rows are read by the neighbours only while computing their
+     own boundary rows of generation t. Both conditions hold once the neighbours published generation t,
+     so the boundary rows are computed first and published before the interior ones.
+     @param a first row of the band
+     @param b row after the last one
+     @param r rule used to compute the next state
+     @param counters generation counters of the bands
+     @param band index of the band
+     @param bands number of bands
+    */
+    template <typename Rule>
+    void neighbourExec(int a, int b, const Rule &r, GenerationCounter *counters, int band, int bands);
+
+    /**
+     Method executed by the pool's threads in the threadsExecution() method.
+     @param id index of the thread
+     @param a starting point of the interval
+     @param b ending point of the interval
+     @param r rule used to compute the next state
+    */
+    template <typename Rule>
+    void exec(int id, int a, int b, const Rule &r);
+
+    /**
+     Function used to random fill the grid. The number used are in the interval [0, states[
+    */
+    void randomFill();
+
+    /**
+     Method used to get all the neighbours of the cell (X,Y)
+     @param x row-index of the cell
+     @param y column-index of the cell
+     @param grid_ reference to the grid from which the neighbourhood will be computed
+     @returns a std::vector<int> containing: the current state of the cell at index [0], then, starting from the top left corner, all the other neighbours in a clockwise sense in the following index. 
+    */
+    std::vector<int> getNeighbourhood(int x, int y, const FlatGrid *grid_);
+
+    /**
+     Same as above, with a neighbourhood of any shape and radius (see neighbourhood.hpp)
+     @returns the current state of the cell at index [0], then the neighbours in the order of shape.offsets()
+    */
+    std::vector<int> getNeighbourhood(int x, int y, const FlatGrid *grid_, const Neighbourhood &shape);
+
+    /**
+     Method used to generate a deep copy of the grid
+     @returns a deep copy of the grid
+    */
+    grid2D copyGrid();
+
+    /**
+     Method that prints the Cellular Automata grid
+    */
+    void printMatrix();
+
+    /**
+     Series of methods to get the next/previous column/row following a toroidal behaviour
+     @param index value of row/column, the methods's name indicated which is the direction followed
+     @returns the next index of row/column in the direction indicated by the methods's name 
+    */
+    int upperRow(int index);
+    int lowerRow(int index);
+    int leftColumn(int index);
+    int rightColumn(int index);
+
+    /**
+     Method used to get the number of states of a grid
+     @param grid_ grid to look at
+     @returns the greatest state in the grid plus one, at least 2
+    */
+    int countStates(const grid2D &grid_);
+
+    /**
+     Method which check the correctness of some of the constructor's parameters.
+     @param rows number of rows
+     @param columns number of columns
+     @param function Cellular Automata's update rule
+     @param tsteps number of timesteps
+     @param numthreads number of threads
+     @returns whether the parameters are correct or not
+    */
+    bool checkParameters(int rows, int columns, int (*function)(neighbourhood), int tsteps, int numthreads);
+
+    /**
+     Setter and Getter methods
+    */ 
+    int getNumThreads();
+    int getRows();
+    int getColumns();
+    int getTimeSteps();
+    grid2D getGrid();
+    void setRows(int rows);
+    void setColumns(int columns);
+    void setGrid(const grid2D &new_grid);
+    void setNumThreads(int threads);
+    void setRule(int (*func)(neighbourhood));
+    
+
+    /**
+     Method enabling the active-tile tracking: only the tiles which changed, or are next to one that changed,
+     during the last step are computed. It's used by all the run methods.
+     @param tile_rows number of rows of a tile, 0 disables the tracking
+     @param tile_columns number of columns of a tile
+    */
+    void setActiveTiles(int tile_rows = DEFAULT_TILE_SIDE, int tile_columns = DEFAULT_TILE_SIDE);
+
+    /**
+     Method returning the fraction of tiles computed at each step of the last run
+    */
+    std::vector<double> getActiveTileFractions();
+
+    /**
+     Methods used to share a worker pool between several automata, so that it's created only once.
+     A pool whose size differs from the number of threads is replaced by a new one at the next threadsExecution()
+    */
+    void setWorkerPool(std::shared_ptr<WorkerPool> workers);
+    std::shared_ptr<WorkerPool> getWorkerPool();
+
+    /**
+     Method enabling the pinning of the threads: thread i of every run method always runs on the same CPU, and the threads
+     are spread over the NUMA nodes in contiguous groups (see numa.hpp). The grid is moved so that each band is on the
+     node of the thread computing it, which is also done by setNumThreads() since the bands change.
+     @param pin whether the threads are pinned
+    */
+    void setThreadPinning(bool pin);
+    bool getThreadPinning();
+
+    /**
+     Method describing the NUMA nodes, the placement of the threads and the node of the grid's pages
+    */
+    std::string topologyReport();
+
+    /**
+     Method enabling the snapshots: every interval generations the current grid is packed and queued to an I/O thread,
+     which writes it to a binary frame file (see snapshot.hpp), so the run doesn't wait for the disk.
+     The run methods without a step boundary (neighbourSyncExecution(), ompTaskWavefront()) only write the generation
+     they end with, ompTemporalBlocking() the ones ending a pass. The file is bound to the size and states of the current grid.
+     @param path file the frames are written to
+     @param interval generations between two frames
+     @param compress whether the frames are run-length compressed
+     @param shadow whether the frames are packed by the I/O thread from the grid buffer itself: the buffer is exchanged
+     with a spare one before it's overwritten, so the run doesn't even wait for the packing (one more grid in memory)
+    */
+    void setSnapshots(const std::string &path, int interval, bool compress = false, bool shadow = false);
+
+    /**
+     Method writing the frames still in the queue and closing the snapshot file
+    */
+    void stopSnapshots();
+
+    /**
+     Method returning the snapshot writer, to read its statistics (e.g. the stall of each frame), nullptr when the snapshots are disabled
+    */
+    const SnapshotWriter *getSnapshotWriter();
+
+    /**
+     Method moving the grid to two memory-mapped files, current and next generation, which are created or truncated.
+     The NUMA placement doesn't apply to mapped grids, and setGrid() copies into the files
+     @param grid_path file of the current generation
+     @param next_path file of the next generation
+    */
+    void setOutOfCore(const std::string &grid_path, const std::string &next_path);
+
+    /**
+     Method saving a checkpoint of the automaton: grid, states, generation counter, rule fingerprint and random generator.
+     The chunks of the grid are encoded and written by the threads of the automaton (see checkpoint.hpp)
+     @param path checkpoint file
+    */
+    void saveCheckpoint(const std::string &path);
+
+    /**
+     Method restoring a checkpoint, the grid takes its size. The rule can't be stored, so the one of the automaton
+     has to be the one the checkpoint was saved with, which is checked through its fingerprint
+     @param path checkpoint file
+    */
+    void loadCheckpoint(const std::string &path);
+
+    /**
+     Method returning the generations computed from the initial grid, restored by loadCheckpoint()
+    */
+    long getGeneration();
+
+    /**
+     Method returning the trace of the last run: time each thread spent computing, waiting and swapping at each generation.
+     It's recorded only when the automaton is compiled with CA_TRACE (see trace.hpp), empty otherwise
+    */
+    const Tracer &getTracer();
+
+    /**
+     Method setting the tile size of workStealingExecution(), when the active-tile tracking is disabled
+     @param tile_rows number of rows of a tile
+     @param tile_columns number of columns of a tile
+    */
+    void setStealingTiles(int tile_rows = DEFAULT_STEALING_TILE_ROWS, int tile_columns = DEFAULT_STEALING_TILE_COLUMNS);
+
+    /**
+     Method returning the busy and idle time of each thread during the last workStealingExecution()
+    */
+    std::vector<WorkerStats> getWorkerStats();
+
+    /**
+     Method setting the tile size of ompTaskWavefront()
+     @param tile_rows number of rows of a tile
+     @param tile_columns number of columns of a tile
+    */
+    void setWavefrontTiles(int tile_rows = DEFAULT_WAVEFRONT_TILE_ROWS, int tile_columns = DEFAULT_WAVEFRONT_TILE_COLUMNS);
+
+    /**
+     Method configuring ompTemporalBlocking()
+     @param depth number of generations computed per pass, i.e. width of the halo
+     @param tile_rows number of rows of a tile
+     @param tile_columns number of columns of a tile
+    */
+    void setTemporalBlocking(int depth = DEFAULT_TEMPORAL_DEPTH, int tile_rows = DEFAULT_TEMPORAL_TILE_ROWS, int tile_columns = DEFAULT_TEMPORAL_TILE_COLUMNS);
+
+    /*
+     The following code refers to another FastFlow implementation in which an explicit declaration of the farm components is made.
+    */
+
+    //First stage of the farm, the emitter node.
+
+    struct firstStage : ff_node_t<TILE, TILE>
+    {
+        CellularAutomata *automata;           /**<Variable representing the automata*/
+        std::vector<TILE> tasks;                /**<One task per tile, recycled for the whole run*/
+        std::vector<int> done;                  /**<Number of generations computed by each tile*/
+        std::vector<char> in_flight;            /**<Whether a tile is being computed by a worker*/
+        int tiles_per_row, tiles_per_column;    /**<Tiles along the columns and the rows*/
+        long completed = 0, total;              /**<Tile generations computed, and to compute*/
+        bool synchronous;                       /**<Step by step execution, used by the active-tile tracking*/
+        int step_done = 0, t = 0;               /**<Synchronous execution: tiles returned in the current step and current step*/
+
+        /**
+         * struct Constructor. 
+         * @param obj Cellular Automata where the simulation will be run
+         *       
+        */
+
+        firstStage(CellularAutomata *obj)
+        {
+            automata = obj;
+            synchronous = automata->tiles.enabled();
+            tiles_per_column = synchronous ? automata->tiles.getTileRows() : (automata->num_rows + automata->farm_tile_rows - 1) / automata->farm_tile_rows;
+            tiles_per_row = synchronous ? automata->tiles.getTileColumns() : (automata->num_columns + automata->farm_tile_columns - 1) / automata->farm_tile_columns;
+            int num_tiles = tiles_per_column * tiles_per_row;
+            for (int k = 0; k < num_tiles; k++)
+                tasks.push_back(TILE{k, k / tiles_per_row, k % tiles_per_row, 0});
+            done.assign(num_tiles, 0);
+            in_flight.assign(num_tiles, 0);
+            total = (long)num_tiles * automata->timesteps;
+        }
+
+        /**
+         Method telling if a tile can compute its next generation: generation g + 1 overwrites the buffer holding g - 1,
+         so every neighbour tile has to be done with g (which also means it doesn't need g - 1 anymore)
+        */
+        bool ready(int k)
+        {
+            int g = done[k];
+            if (in_flight[k] || g == automata->timesteps)
+                return false;
+            int ti = tasks[k].tile_row, tj = tasks[k].tile_column;
+            for (int di = -1; di <= 1; di++)
+                for (int dj = -1; dj <= 1; dj++)
+                {
+                    int i = (ti + di + tiles_per_column) % tiles_per_column, j = (tj + dj + tiles_per_row) % tiles_per_row;
+                    if (done[i * tiles_per_row + j] < g)
+                        return false;
+                }
+            return true;
+        }
+
+        void issue(int k)
+        {
+            tasks[k].generation = done[k];
+            in_flight[k] = 1;
+            ff_send_out(&tasks[k]);
+        }
+
+        /**
+         Function executing the Emitter job.
+         At the beginning every tile is sent out, then each tile coming back over the feedback channel releases
+         the neighbour tiles whose dependencies are satisfied, so different tiles can be at different generations
+         and no step-wide synchronization is needed.
+         With the active-tile tracking the flags are updated step by step, so a new step starts when every tile came back.
+        */
+
+        TILE *svc(TILE *task)
+        {
+            if (task == nullptr)
+            {
+                for (size_t k = 0; k < tasks.size(); k++)
+                    issue(k);
+                return GO_ON;
+            }
+            int k = task->index;
+            in_flight[k] = 0;
+            done[k]++;
+            if (synchronous)
+            {
+                if (++step_done < (int)tasks.size())
+                    return GO_ON;
+                //Every tile came back: the computed generation becomes the current one
+                step_done = 0;
+                TRACE_TIME(swap);
+                automata->endStep();
+                TRACE_RECORD(automata->tracer, TRACE_MAIN, TRACE_SWAP, t, swap);
+                if (++t == automata->timesteps)
+                    return EOS;
+                for (size_t i = 0; i < tasks.size(); i++)
+                    issue(i);
+                return GO_ON;
+            }
+            if (++completed == total)
+                return EOS;
+            int ti = task->tile_row, tj = task->tile_column;
+            for (int di = -1; di <= 1; di++)
+                for (int dj = -1; dj <= 1; dj++)
+                {
+                    int m = ((ti + di + tiles_per_column) % tiles_per_column) * tiles_per_row + (tj + dj + tiles_per_row) % tiles_per_row;
+                    if (ready(m))
+                        issue(m);
+                }
+            return GO_ON;
+        }
+    };
+
+    //Second stage of the farm, the worker nodes
+    template <typename Rule>
+    struct secondStage : ff_node_t<TILE, TILE>
+    {
+        CellularAutomata *automata; /**<Cellular Automata where the simulation is run */
+        Rule rule;                    /**<Rule used to compute the next state*/
+
+        /**
+         Constructor
+         @param ca reference to the cellular automata
+         @param r rule used to compute the next state
+         */
+        secondStage(CellularAutomata *ca, const Rule &r) : rule(r)
+        {
+            automata = ca;
+        }
+
+        /**
+         The worker is pinned before receiving tiles, replacing the default mapping of FastFlow
+        */
+        int svc_init()
+        {
+            if (automata->pinning)
+                ThreadPlacement::topology().pin(get_my_id(), automata->num_threads);
+            return 0;
+        }
+
+        /**
+         Workers's job function. Each time a worker receives a tile it computes it and sends the same task back.
+        */
+        TILE *svc(TILE *task)
+        {
+            //The worker waited in the farm since its last tile
+            TRACE_IDLE(automata->tracer, get_my_id(), task->generation);
+            TRACE_TIME(compute);
+            automata->sweepTile(*task, rule);
+            TRACE_RECORD(automata->tracer, get_my_id(), TRACE_COMPUTE, task->generation, compute);
+            return task;
+        }
+    };
+
+    /**
+     Function to declare the nodes, build the farm and run it.
+     Both Emitter and worker are initialized with the current CellularAutomata.
+     Workers are replicated using a std::vector.
+    */
+    int startFarm()
+    {
+        int result = 0;
+        withCompiledRule([this, &result](const auto &r) { result = startFarm(r); });
+        return result;
+    }
+
+    /**
+     Templated version of startFarm(), the rule functor is copied in every worker.
+     @param r rule used to compute the next state of each cell
+    */
+    template <typename Rule>
+    int startFarm(const Rule &r)
+    {
+        utimer farmTime("Fastflow farm time:");
+        beginRun();
+        farm_buffers[0] = &grid.current();
+        farm_buffers[1] = &grid.next();
+        firstStage emitter(this);
+        //A worker records a wait and a compute event per tile
+        TRACE_RUN(tracer, "startFarm", num_threads, (size_t)timesteps * 2 * (emitter.tasks.size() / num_threads + TRACE_EVENTS_PER_STEP));
+        std::vector<std::unique_ptr<ff_node>> Workers;
+        for (int i = 0; i < num_threads; i++)
+            Workers.push_back(make_unique<secondStage<Rule>>(this, r));
+        ff_Farm<TILE> farm(std::move(Workers), emitter);
+        farm.remove_collector();         //This is removed in order to have one more free thread.
+        farm.wrap_around();              //Creates a channel between the workers and the emitter
+        farm.set_scheduling_ondemand();  //A tile goes to the first worker with a free slot
+        if (farm.run_and_wait_end() < 0)
+        {
+            error("running farm");
+            return -1;
+        }
+        //Without the tracking the tiles used the buffers by parity, after an odd number of generations the result is in the next buffer
+        if (!tiles.enabled())
+        {
+            TRACE_TIME(swap);
+            if (timesteps % 2 == 1)
+                grid.swap();
+            endGenerations(timesteps);
+            TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, timesteps - 1, swap);
+        }
+        return 0;
+    }
+
+    /**
+     Method setting the tile size of the farm, used when the active-tile tracking is disabled
+     @param tile_rows number of rows of a tile
+     @param tile_columns number of columns of a tile
+    */
+    void setFarmTiles(int tile_rows = DEFAULT_FARM_TILE_ROWS, int tile_columns = DEFAULT_FARM_TILE_COLUMNS);
+
+    /**
+     Method setting how many bands (rows, or tile-rows with the active-tile tracking) a task of fastFlowParallelFor() computes
+     @param grain bands per task
+    */
+    void setParallelForGrain(int grain = DEFAULT_PARALLEL_FOR_GRAIN);
+
+    /**
+     Method choosing the fastest configuration for this machine, grid shape and rule, and applying it.
+     With a cached configuration nothing is run. Otherwise every backend is timed over the thread counts
+     (powers of two up to the hardware threads), then the tile or chunk size of the fastest one is tuned, and the result is cached.
+     The trials start from the current grid and don't touch the snapshots, the grid and the generation are restored after them.
+     @param cache_path cache of the configurations (see autotune.hpp)
+     @param trial_steps generations of each trial run
+     @param retune whether the trials are run even with a cached configuration
+     @returns the configuration, to be run with run(config.backend)
+    */
+    TunedConfig autotune(const std::string &cache_path = DEFAULT_TUNE_CACHE, int trial_steps = DEFAULT_TUNE_STEPS, bool retune = false);
+
+    /**
+     Method applying a configuration: number of threads, tile size of its backend and parallel for grain
+    */
+    void applyConfig(const TunedConfig &config);
+
+    /**
+     Method used to re-initialize the grid
+    */
+    void restartGrid();
+};
+
+/*
+ Body of the templated run methods, they have to be visible to the callers.
+*/
+
+template <typename Body>
+void CellularAutomata::withCompiledRule(const Body &body)
+{
+    OuterTotalisticRule totalistic;
+    if (totalisticEquivalent(rule, states, &totalistic))
+        body(OuterTotalistic{totalistic});
+    else if (table.compile(rule, states))
+    {
+        if (table.isTotalistic())
+            body(table.totalisticLookup());
+        else if (states == 2)
+            body(table.binaryLookup());
+        else
+            body(table.patternLookup());
+    }
+    else
+        body(FunctionRule{rule});
+}
+
+template <typename Rule>
+void CellularAutomata::sweepBand(int a, int b, const Rule &r)
+{
+    if (tiles.enabled())
+        tiles.sweep(grid.current(), grid.next(), a, b, r);
+    else
+        stencilSweep(grid.current(), grid.next(), a, b, r);
+}
+
+template <typename Rule>
+void CellularAutomata::sequentialRun(const Rule &r)
+{
+    //Starting the timer
+    utimer tseq("Sequential time:");
+    int bands = beginRun();
+    TRACE_RUN(tracer, "sequentialRun", 0, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+    for (int t = 0; t < timesteps; t++)
+    {
+        //The next state is computed from the current one, then the buffers are swapped
+        TRACE_TIME(compute);
+        sweepBand(0, bands, r);
+        TRACE_RECORD(tracer, TRACE_MAIN, TRACE_COMPUTE, t, compute);
+        TRACE_TIME(swap);
+        endStep();
+        TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, t, swap);
+    }
+    //tseq.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::threadsExecution(const Rule &r)
+{
+    //The commented section of the code was used to generate results
+    //std::string message = "Thread Execution with" + (std::to_string(num_threads)) + " Threads";
+    utimer tpar("Thread Execution time:");
+    WorkerPool &workers = workerPool();
+    int bands = beginRun();
+    int delta = bands / num_threads;
+    int exceeded = bands % num_threads;
+    TRACE_RUN(tracer, "threadsExecution", num_threads, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+    workers.run([this, &r, delta, exceeded](int id)
+                {
+                    //The first exceeded threads get one more band, so that every band is computed exactly once
+                    int a = id * delta + std::min(id, exceeded);
+                    exec(id, a, a + delta + (id < exceeded ? 1 : 0), r);
+                });
+    //tpar.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::exec([[maybe_unused]] int id, int a, int b, const Rule &r)
+{
+    WorkerPool &workers = *pool;
+    for (int t = 0; t < timesteps; t++)
+    {
+        //The buffers are read again each timestep since they're swapped
+        TRACE_TIME(compute);
+        sweepBand(a, b, r);
+        TRACE_RECORD(tracer, id, TRACE_COMPUTE, t, compute);
+        //The last thread reaching the barrier swaps the buffers, then all the threads move to the next generation
+        workers.sync([&]()
+                     {
+                         TRACE_TIME(swap);
+                         endStep();
+                         TRACE_RECORD(tracer, id, TRACE_SWAP, t, swap);
+                     });
+        TRACE_IDLE(tracer, id, t);
+    }
+}
+
+template <typename Rule>
+void CellularAutomata::ompParallelFor(const Rule &r)
+{
+    //Commented lines of code were used to generate the results
+    //std::string message = "OMP parallel For with" + (std::to_string(numthreads)) + " Threads";
+    //Starting the timer
+    utimer my_timer("OpenMP parallel for time:");
+    pinOmpThreads();
+    int bands = beginRun();
+    //With the active-tile tracking the cost of a band varies, so the bands are scheduled dynamically
+    omp_set_schedule(tiles.enabled() ? omp_sched_dynamic : omp_sched_static, 0);
+    TRACE_RUN(tracer, "ompParallelFor", num_threads, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+    for (int t = 0; t < timesteps; t++)
+    {
+#pragma omp parallel for num_threads(num_threads) schedule(runtime)
+        for (int i = 0; i < bands; i++)
+        {
+            //compute the rule on the cells of the i-th band
+            TRACE_TIME(compute);
+            sweepBand(i, i + 1, r);
+            TRACE_RECORD(tracer, omp_get_thread_num(), TRACE_COMPUTE, t, compute);
+        }
+        TRACE_CLOSE(tracer, t);
+        TRACE_TIME(swap);
+        endStep(); //the implicit barrier of the parallel for guarantees the next generation is complete
+        TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, t, swap);
+    }
+    //my_timer.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::workStealingExecution(const Rule &r)
+{
+    utimer tpar("Work-stealing execution time:");
+    WorkerPool &workers = workerPool();
+    beginRun();
+    //Tiles are numbered row by row, the active tiles are used when the tracking is enabled
+    int tile_rows = std::min(stealing_tile_rows, num_rows), tile_columns = std::min(stealing_tile_columns, num_columns);
+    int tiles_per_row = tiles.enabled() ? tiles.getTileColumns() : (num_columns + tile_columns - 1) / tile_columns;
+    int tiles_per_column = tiles.enabled() ? tiles.getTileRows() : (num_rows + tile_rows - 1) / tile_rows;
+    scheduler.configure(num_threads, tiles_per_row * tiles_per_column);
+    TRACE_RUN(tracer, "workStealingExecution", num_threads, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+    workers.run([&](int id)
+                {
+                    for (int t = 0; t < timesteps; t++)
+                    {
+                        const FlatGrid &src = grid.current();
+                        FlatGrid &dst = grid.next();
+                        TRACE_TIME(compute);
+                        scheduler.work(id, [&](int k)
+                                       {
+                                           int ti = k / tiles_per_row, tj = k % tiles_per_row;
+                                           if (tiles.enabled())
+                                               tiles.sweepTile(src, dst, ti, tj, r);
+                                           else
+                                               stencilSweep(src, dst, ti * tile_rows, std::min(num_rows, (ti + 1) * tile_rows),
+                                                            tj * tile_columns, std::min(num_columns, (tj + 1) * tile_columns), r);
+                                       });
+                        TRACE_RECORD(tracer, id, TRACE_COMPUTE, t, compute);
+                        auto wait = std::chrono::steady_clock::now();
+                        //The last thread reaching the barrier closes the step and re-arms the scheduler
+                        workers.sync([&]()
+                                     {
+                                         TRACE_TIME(swap);
+                                         endStep();
+                                         scheduler.beginStep();
+                                         TRACE_RECORD(tracer, id, TRACE_SWAP, t, swap);
+                                     });
+                        TRACE_IDLE(tracer, id, t);
+                        scheduler.addIdle(id, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wait).count());
+                    }
+                });
+    //tpar.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::neighbourSyncExecution(const Rule &r)
+{
+    utimer tpar("Neighbour synchronization execution time:");
+    //The buffers are written out of step order, so a shadow snapshot has to be written first
+    settleSnapshots();
+    WorkerPool &workers = workerPool();
+    //A band needs at least a row, otherwise its neighbours wouldn't be the adjacent rows
+    int bands = std::min(num_threads, num_rows);
+    int delta = num_rows / bands;
+    int exceeded = num_rows % bands;
+    std::unique_ptr<GenerationCounter[]> counters(new GenerationCounter[bands]);
+    TRACE_RUN(tracer, "neighbourSyncExecution", num_threads, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+    workers.run([&](int id)
+                {
+                    if (id >= bands)
+                        return;
+                    int a = id * delta + std::min(id, exceeded);
+                    neighbourExec(a, a + delta + (id < exceeded ? 1 : 0), r, counters.get(), id, bands);
+                });
+    //The bands used the buffers by parity, after an odd number of generations the result is in the next buffer
+    TRACE_TIME(swap);
+    if (timesteps % 2 == 1)
+        grid.swap();
+    endGenerations(timesteps);
+    TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, timesteps - 1, swap);
+    //tpar.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::neighbourExec(int a, int b, const Rule &r, GenerationCounter *counters, int band, int bands)
+{
+    FlatGrid *buffers[2] = {&grid.current(), &grid.next()};
+    const GenerationCounter &upper = counters[band == 0 ? bands - 1 : band - 1];
+    const GenerationCounter &lower = counters[band == bands - 1 ? 0 : band + 1];
+    for (int t = 0; t < timesteps; t++)
+    {
+        const FlatGrid &src = *buffers[t % 2];
+        FlatGrid &dst = *buffers[(t + 1) % 2];
+        TRACE_TIME(wait);
+        upper.waitFor(t);
+        lower.waitFor(t);
+        TRACE_RECORD(tracer, band, TRACE_WAIT, t, wait);
+        //Boundary rows first, the neighbours wait for them
+        TRACE_TIME(compute);
+        stencilSweep(src, dst, a, a + 1, r);
+        if (b - 1 > a)
+            stencilSweep(src, dst, b - 1, b, r);
+        counters[band].publish(t + 1);
+        //The interior only depends on the rows of the band
+        stencilSweep(src, dst, a + 1, b - 1 > a + 1 ? b - 1 : a + 1, r);
+        TRACE_RECORD(tracer, band, TRACE_COMPUTE, t, compute);
+    }
+}
+
+template <typename Rule>
+void CellularAutomata::ompTaskWavefront(const Rule &r)
+{
+    utimer my_timer("OpenMP task wavefront time:");
+    //The buffers are written out of step order, so a shadow snapshot has to be written first
+    settleSnapshots();
+    pinOmpThreads();
+    int tile_rows = std::min(wavefront_tile_rows, num_rows), tile_columns = std::min(wavefront_tile_columns, num_columns);
+    int tiles_per_column = (num_rows + tile_rows - 1) / tile_rows;
+    int tiles_per_row = (num_columns + tile_columns - 1) / tile_columns;
+    int num_tiles = tiles_per_column * tiles_per_row;
+    FlatGrid *buffers[2] = {&grid.current(), &grid.next()};
+    //Dependency objects of the tiles, generation g is tracked by the sentinels [(g % 2) * num_tiles, ...[.
+    //Reusing them also orders the write of generation g + 1 of a tile after the reads of generation g - 1 by its neighbours
+    std::vector<char> sentinels(2 * num_tiles);
+    char *sentinel = sentinels.data();
+    //A lane records at most an event per task and a wait per generation
+    TRACE_RUN(tracer, "ompTaskWavefront", num_threads, (size_t)timesteps * (num_tiles / num_threads + TRACE_EVENTS_PER_STEP));
+#pragma omp parallel num_threads(num_threads)
+#pragma omp single
+    for (int t = 0; t < timesteps; t++)
+    {
+        char *previous = sentinel + (t % 2) * num_tiles, *computed = sentinel + ((t + 1) % 2) * num_tiles;
+        for (int k = 0; k < num_tiles; k++)
+        {
+            int ti = k / tiles_per_row, tj = k % tiles_per_row;
+            int up = (ti + tiles_per_column - 1) % tiles_per_column * tiles_per_row, mid = ti * tiles_per_row, down = (ti + 1) % tiles_per_column * tiles_per_row;
+            int left = (tj + tiles_per_row - 1) % tiles_per_row, right = (tj + 1) % tiles_per_row;
+#pragma omp task firstprivate(t, ti, tj) depend(in : previous[up + left], previous[up + tj], previous[up + right],           \
+                                                     previous[mid + left], previous[mid + tj], previous[mid + right],        \
+                                                     previous[down + left], previous[down + tj], previous[down + right]) \
+    depend(out : computed[mid + tj])
+            {
+                TRACE_TIME(compute);
+                int row_begin = ti * tile_rows, column_begin = tj * tile_columns;
+                stencilSweep(*buffers[t % 2], *buffers[(t + 1) % 2], row_begin, std::min(num_rows, row_begin + tile_rows),
+                             column_begin, std::min(num_columns, column_begin + tile_columns), r);
+                TRACE_RECORD(tracer, omp_get_thread_num(), TRACE_COMPUTE, t, compute);
+            }
+        }
+    }
+    TRACE_CLOSE(tracer, timesteps - 1);
+    //The tasks used the buffers by parity, after an odd number of generations the result is in the next buffer
+    TRACE_TIME(swap);
+    if (timesteps % 2 == 1)
+        grid.swap();
+    endGenerations(timesteps);
+    TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, timesteps - 1, swap);
+    //my_timer.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::ompTemporalBlocking(const Rule &r)
+{
+    utimer my_timer("OpenMP temporal blocking time:");
+    pinOmpThreads();
+    int tile_rows = std::min(temporal_tile_rows, num_rows), tile_columns = std::min(temporal_tile_columns, num_columns);
+    int tiles_per_column = (num_rows + tile_rows - 1) / tile_rows;
+    int tiles_per_row = (num_columns + tile_columns - 1) / tile_columns;
+    int num_tiles = tiles_per_column * tiles_per_row;
+    TRACE_RUN(tracer, "ompTemporalBlocking", num_threads, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+#pragma omp parallel num_threads(num_threads)
+    {
+        //Private scratch of the thread, allocated once for the whole run
+        TemporalBlock block(tile_rows, tile_columns, temporal_depth);
+        for (int t = 0; t < timesteps; t += temporal_depth)
+        {
+            int steps = std::min(temporal_depth, timesteps - t);
+#pragma omp for schedule(static)
+            for (int k = 0; k < num_tiles; k++)
+            {
+                TRACE_TIME(compute);
+                int row_begin = (k / tiles_per_row) * tile_rows, column_begin = (k % tiles_per_row) * tile_columns;
+                block.advance(grid.current(), grid.next(), row_begin, std::min(num_rows, row_begin + tile_rows),
+                              column_begin, std::min(num_columns, column_begin + tile_columns), steps, r);
+                TRACE_RECORD(tracer, omp_get_thread_num(), TRACE_COMPUTE, t, compute);
+            }
+            //The implicit barrier of the for guarantees every tile is written, a single thread swaps the buffers
+#pragma omp single
+            {
+                TRACE_CLOSE(tracer, t);
+                TRACE_TIME(swap);
+                grid.swap();
+                endGenerations(steps);
+                TRACE_RECORD(tracer, omp_get_thread_num(), TRACE_SWAP, t, swap);
+            }
+        }
+    }
+    //my_timer.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::outOfCoreRun(const Rule &r)
+{
+    utimer tooc("Out-of-core execution time:");
+    pinOmpThreads();
+    //Rows per band, so that a band of both generations fits the budget
+    size_t row_bytes = sizeof(int) * (size_t)grid.current().getStride();
+    int band = (int)std::max<size_t>(1, std::min<size_t>(num_rows, OUT_OF_CORE_BAND_BYTES / (2 * row_bytes)));
+    //The main lane records the read-ahead and drop-behind of each band
+    TRACE_RUN(tracer, "outOfCoreRun", num_threads, (size_t)timesteps * (2 * ((num_rows + band - 1) / band) + TRACE_EVENTS_PER_STEP));
+    for (int t = 0; t < timesteps; t++)
+    {
+        const FlatGrid &src = grid.current();
+        FlatGrid &dst = grid.next();
+        //The first band also reads the last row
+        src.prefetchRows(num_rows - 1, num_rows);
+        src.prefetchRows(0, std::min(num_rows, band + 1));
+        for (int a = 0; a < num_rows; a += band)
+        {
+            int b = std::min(num_rows, a + band);
+            //Read-ahead of the next band, and of the row below it, while this one is computed
+            TRACE_TIME(prefetch);
+            src.prefetchRows(b + 1, std::min(num_rows, b + band + 1));
+            TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, t, prefetch);
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+            for (int i = a; i < b; i++)
+            {
+                TRACE_TIME(compute);
+                stencilSweep(src, dst, i, i + 1, r);
+                TRACE_RECORD(tracer, omp_get_thread_num(), TRACE_COMPUTE, t, compute);
+            }
+            //Drop-behind: the next band only reads row b - 1 of the current generation, and the last band reads row 0
+            TRACE_TIME(release);
+            src.releaseRows(std::max(1, a - 1), b - 1);
+            dst.releaseRows(a, b);
+            TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, t, release);
+        }
+        TRACE_CLOSE(tracer, t);
+        //The active-tile tracking isn't used here, so the step is closed without it
+        TRACE_TIME(swap);
+        grid.swap();
+        endGenerations(1);
+        TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, t, swap);
+    }
+    //tooc.printOnReport();
+}
+
+template <typename Rule>
+void CellularAutomata::sweepTile(const TILE &task, const Rule &r)
+{
+    if (tiles.enabled())
+    {
+        tiles.sweepTile(grid.current(), grid.next(), task.tile_row, task.tile_column, r);
+        return;
+    }
+    int row_begin = task.tile_row * farm_tile_rows, column_begin = task.tile_column * farm_tile_columns;
+    stencilSweep(*farm_buffers[task.generation % 2], *farm_buffers[(task.generation + 1) % 2],
+                 row_begin, std::min(num_rows, row_begin + farm_tile_rows), column_begin, std::min(num_columns, column_begin + farm_tile_columns), r);
+}
+
+template <typename Rule>
+void CellularAutomata::fastFlowParallelFor(const Rule &r)
+{
+    //The commented lines were used to generate results in the reports
+    //std::string message = "FastFlow execution with" + (std::to_string(num_threads)) + " Threads";
+    //timer is started
+    utimer tff("Fastflow parallel for time:");
+    ParallelFor pf(num_threads);
+    int bands = beginRun();
+    TRACE_RUN(tracer, "fastFlowParallelFor", num_threads, (size_t)timesteps * TRACE_EVENTS_PER_STEP);
+    //A block of rows per worker when the threads are pinned, so that each worker computes the band placed on its node
+    long chunk = pinning && !tiles.enabled() ? 0 : parallel_for_grain;
+    if (pinning)
+        pf.parallel_for_thid(
+            0, num_threads, 1, 0, [this](const long, const int thid)
+            {
+                ThreadPlacement::topology().pin(thid, num_threads);
+            },
+            num_threads);
+    for (int t = 0; t < timesteps; t++)
+    {
+        //Bands (rows or tile-rows) are given to the workers in chunks of parallel_for_grain, or in blocks with the pinning
+        pf.parallel_for_thid(
+            0, bands, 1, chunk, [&](const long i, [[maybe_unused]] const int thid)
+            {
+                TRACE_TIME(compute);
+                sweepBand(i, i + 1, r);
+                TRACE_RECORD(tracer, thid, TRACE_COMPUTE, t, compute);
+            },
+            num_threads);
+        //parallel_for returns once every band is computed, the buffers can be swapped
+        TRACE_CLOSE(tracer, t);
+        TRACE_TIME(swap);
+        endStep();
+        TRACE_RECORD(tracer, TRACE_MAIN, TRACE_SWAP, t, swap);
+    }
+    //tff.printOnReport();
+}
+
+#endif
@@ -0,0 +1,246 @@
+#include "checkpoint.hpp"
+#include <iostream>
+#include <cstring>
+#include <omp.h>
+
+/**
+    @brief Methods body of the checkpoint.hpp file.
+    @file checkpoint.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#define RULE_ID_PATTERNS (1 << 16) /**<Neighbourhoods evaluated by ruleId()*/
+
+//Header fields after the magic
+struct CheckpointHeader
+{
+    uint32_t version;
+    int32_t rows, columns, states;
+    uint32_t flags;
+    int64_t generation;
+    uint64_t rule_id;
+    int32_t chunk_rows;
+    uint32_t chunks, random_bytes;
+};
+
+//The fields are written one by one at the offsets of checkpoint.hpp, so the file has no padding
+template <typename T>
+static inline void putField(std::vector<char> &bytes, size_t &offset, T value)
+{
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    offset += sizeof(T);
+}
+
+template <typename T>
+static inline void getField(const char *bytes, size_t &offset, T &value)
+{
+    std::memcpy(&value, bytes + offset, sizeof(T));
+    offset += sizeof(T);
+}
+
+static std::vector<char> encodeHeader(const CheckpointHeader &header)
+{
+    std::vector<char> bytes(CHECKPOINT_HEADER_BYTES);
+    std::memcpy(bytes.data(), "CACK", 4);
+    size_t offset = 4;
+    putField(bytes, offset, header.version);
+    putField(bytes, offset, header.rows);
+    putField(bytes, offset, header.columns);
+    putField(bytes, offset, header.states);
+    putField(bytes, offset, header.flags);
+    putField(bytes, offset, header.generation);
+    putField(bytes, offset, header.rule_id);
+    putField(bytes, offset, header.chunk_rows);
+    putField(bytes, offset, header.chunks);
+    putField(bytes, offset, header.random_bytes);
+    return bytes;
+}
+
+//Returns false when the magic doesn't match
+static bool decodeHeader(const char *bytes, CheckpointHeader &header)
+{
+    if (std::memcmp(bytes, "CACK", 4) != 0)
+        return false;
+    size_t offset = 4;
+    getField(bytes, offset, header.version);
+    getField(bytes, offset, header.rows);
+    getField(bytes, offset, header.columns);
+    getField(bytes, offset, header.states);
+    getField(bytes, offset, header.flags);
+    getField(bytes, offset, header.generation);
+    getField(bytes, offset, header.rule_id);
+    getField(bytes, offset, header.chunk_rows);
+    getField(bytes, offset, header.chunks);
+    getField(bytes, offset, header.random_bytes);
+    return true;
+}
+
+uint64_t ruleId(int (*function)(neighbourhood), int n_states)
+{
+    //FNV-1a of the outputs
+    uint64_t hash = 1469598103934665603ull;
+    long patterns = 1;
+    for (int i = 0; i < 9 && patterns <= RULE_ID_PATTERNS; i++)
+        patterns *= n_states;
+    bool sampled = patterns > RULE_ID_PATTERNS;
+    uint64_t seed = 88172645463325252ull;
+    neighbourhood nb(9);
+    for (long key = 0; key < std::min<long>(patterns, RULE_ID_PATTERNS); key++)
+    {
+        //Digit k of the key, or of a xorshift value when sampling, is the k-th cell
+        uint64_t digits = key;
+        if (sampled)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            digits = seed;
+        }
+        for (int k = 0; k < 9; k++, digits /= n_states)
+            nb[k] = digits % n_states;
+        uint32_t out = function(nb);
+        for (int b = 0; b < 4; b++)
+            hash = (hash ^ ((out >> (8 * b)) & 0xff)) * 1099511628211ull;
+    }
+    return hash ^ (uint64_t)n_states;
+}
+
+void saveCheckpoint(const std::string &path, const FlatGrid &grid, const CheckpointState &state, int threads)
+{
+    if (state.states > 256 || state.rows != grid.getRows() || state.columns != grid.getColumns())
+    {
+        std::cerr << "Error: a checkpoint needs at most 256 states and the size of the grid" << std::endl;
+        exit(-1);
+    }
+    bool bits = state.states <= 2;
+    CheckpointHeader header;
+    header.version = CHECKPOINT_VERSION;
+    header.rows = state.rows;
+    header.columns = state.columns;
+    header.states = state.states;
+    header.flags = bits ? SNAPSHOT_BITS : 0;
+    header.generation = state.generation;
+    header.rule_id = state.rule_id;
+    header.chunk_rows = std::max(1, std::min(state.rows, CHECKPOINT_CHUNK_CELLS / std::max(1, state.columns)));
+    header.chunks = (state.rows + header.chunk_rows - 1) / header.chunk_rows;
+    header.random_bytes = state.random.size();
+
+    //Each chunk is packed and compressed on its own
+    std::vector<std::vector<uint8_t>> chunks(header.chunks);
+#pragma omp parallel num_threads(threads)
+    {
+        std::vector<uint8_t> packed;
+#pragma omp for schedule(dynamic)
+        for (int c = 0; c < (int)header.chunks; c++)
+        {
+            int a = c * header.chunk_rows, b = std::min(state.rows, a + header.chunk_rows);
+            packed.resize(packedRowBytes(state.columns, bits) * (b - a));
+            packRows(grid, a, b, bits, packed.data());
+            packBits(packed.data(), packed.size(), chunks[c]);
+        }
+    }
+
+    //The index is known once every chunk has its size
+    size_t offset = CHECKPOINT_HEADER_BYTES + state.random.size() + 2 * sizeof(uint64_t) * header.chunks;
+    std::vector<uint64_t> index(2 * header.chunks);
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+        index[2 * c] = offset;
+        index[2 * c + 1] = chunks[c].size();
+        offset += chunks[c].size();
+    }
+    std::vector<char> head = encodeHeader(header);
+    head.insert(head.end(), state.random.begin(), state.random.end());
+    head.insert(head.end(), (const char *)index.data(), (const char *)(index.data() + index.size()));
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool failed = fd < 0 || pwrite(fd, head.data(), head.size(), 0) != (ssize_t)head.size();
+#pragma omp parallel for num_threads(threads) schedule(dynamic) reduction(|| : failed)
+    for (int c = 0; c < (int)header.chunks; c++)
+        if (fd >= 0 && pwrite(fd, chunks[c].data(), chunks[c].size(), index[2 * c]) != (ssize_t)chunks[c].size())
+            failed = true;
+    if (fd >= 0)
+        close(fd);
+    if (failed)
+    {
+        std::cerr << "Error: writing the checkpoint " << path << " failed" << std::endl;
+        exit(-1);
+    }
+}
+
+CheckpointFile::CheckpointFile(const std::string &file_path) : path(file_path)
+{
+    fd = open(path.c_str(), O_RDONLY);
+    char head[CHECKPOINT_HEADER_BYTES] = {0};
+    CheckpointHeader header;
+    if (fd < 0 || pread(fd, head, CHECKPOINT_HEADER_BYTES, 0) != CHECKPOINT_HEADER_BYTES || !decodeHeader(head, header) ||
+        header.version != CHECKPOINT_VERSION ||
+        header.rows <= 0 || header.columns <= 0 || header.chunk_rows <= 0 ||
+        header.states < 2 || header.states > 256 || header.flags != (header.states <= 2 ? SNAPSHOT_BITS : 0u) ||
+        header.chunks != (uint32_t)((header.rows + header.chunk_rows - 1) / header.chunk_rows))
+    {
+        std::cerr << "Error: " << path << " isn't a checkpoint" << std::endl;
+        exit(-1);
+    }
+    state.rows = header.rows;
+    state.columns = header.columns;
+    state.states = header.states;
+    state.generation = header.generation;
+    state.rule_id = header.rule_id;
+    state.random.resize(header.random_bytes);
+    flags = header.flags;
+    chunk_rows = header.chunk_rows;
+    index.resize(2 * header.chunks);
+    size_t offset = CHECKPOINT_HEADER_BYTES;
+    if (pread(fd, &state.random[0], header.random_bytes, offset) != (ssize_t)header.random_bytes ||
+        pread(fd, index.data(), sizeof(uint64_t) * index.size(), offset + header.random_bytes) != (ssize_t)(sizeof(uint64_t) * index.size()))
+    {
+        std::cerr << "Error: the checkpoint " << path << " is truncated" << std::endl;
+        exit(-1);
+    }
+}
+
+CheckpointFile::~CheckpointFile()
+{
+    if (fd >= 0)
+        close(fd);
+}
+
+void CheckpointFile::load(FlatGrid &grid, int threads)
+{
+    if (grid.getRows() != state.rows || grid.getColumns() != state.columns)
+    {
+        std::cerr << "Error: the grid doesn't match the size of the checkpoint" << std::endl;
+        exit(-1);
+    }
+    bool bits = flags & SNAPSHOT_BITS, failed = false;
+    int chunks = index.size() / 2;
+#pragma omp parallel num_threads(threads) reduction(|| : failed)
+    {
+        std::vector<uint8_t> compressed, packed;
+#pragma omp for schedule(dynamic)
+        for (int c = 0; c < chunks; c++)
+        {
+            int a = c * chunk_rows, b = std::min(state.rows, a + chunk_rows);
+            compressed.resize(index[2 * c + 1]);
+            if (pread(fd, compressed.data(), compressed.size(), index[2 * c]) != (ssize_t)compressed.size())
+            {
+                failed = true;
+                continue;
+            }
+            unpackBits(compressed.data(), compressed.size(), packed);
+            if (packed.size() != packedRowBytes(state.columns, bits) * (b - a))
+            {
+                failed = true;
+                continue;
+            }
+            unpackRows(packed.data(), bits, grid, a, b);
+        }
+    }
+    if (failed)
+    {
+        std::cerr << "Error: the checkpoint " << path << " is corrupted" << std::endl;
+        exit(-1);
+    }
+}
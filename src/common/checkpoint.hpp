@@ -0,0 +1,93 @@
+/**
+    @brief Checkpoint and restart of a whole automaton.
+    A checkpoint holds the grid, the number of states, the generation reached, a fingerprint of the rule and the state of
+    the random generator. The grid is split in chunks of rows which are packed (one bit per cell for the two-state
+    automata, one byte otherwise) and PackBits compressed independently, and a chunk index gives the position of each one,
+    so the threads encode and write, or read and decode, different chunks in parallel.
+    File layout, in the byte order of the machine, without padding:
+      header (CHECKPOINT_HEADER_BYTES bytes, offset of each field in brackets):
+               [0] "CACK", [4] uint32 version, [8] int32 rows, [12] int32 columns, [16] int32 states,
+               [20] uint32 flags (SNAPSHOT_BITS), [24] int64 generation, [32] uint64 rule id, [40] int32 rows per chunk,
+               [44] uint32 chunks, [48] uint32 random state bytes
+      [52] random generator state (text), chunk index (uint64 offset and size of each chunk), chunks
+    @file checkpoint.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "grid.hpp"
+#include "snapshot.hpp"
+#ifndef CA_CHECKPOINT_H
+#define CA_CHECKPOINT_H
+
+#define CHECKPOINT_VERSION 1            /**<Version of the file layout*/
+#define CHECKPOINT_CHUNK_CELLS (1 << 20) /**<Cells per chunk, rounded to whole rows*/
+#define CHECKPOINT_HEADER_BYTES 52       /**<Bytes of the header, magic included*/
+
+//Defining aliases
+using neighbourhood = std::vector<int>;
+
+/**
+ Everything but the grid
+*/
+struct CheckpointState
+{
+    int rows = 0, columns = 0, states = 0;
+    long generation = 0;  /**<Generations computed from the initial grid*/
+    uint64_t rule_id = 0; /**<Fingerprint of the rule, see ruleId()*/
+    std::string random;   /**<State of the random generator, as written by operator<<*/
+};
+
+/**
+ Method computing a fingerprint of a rule from its outputs: on every neighbourhood when there are at most
+ 2^16 of them, on a fixed sample otherwise. Function pointers can't be stored, so the restart checks the rule
+ it's given against this value
+ @param function rule
+ @param n_states number of states
+*/
+uint64_t ruleId(int (*function)(neighbourhood), int n_states);
+
+/**
+ Method writing a checkpoint, the chunks are encoded and written by threads threads
+ @param path checkpoint file, it's truncated
+ @param grid current generation
+ @param state the rest of the automaton, its size has to match the grid
+ @param threads number of OpenMP threads
+*/
+void saveCheckpoint(const std::string &path, const FlatGrid &grid, const CheckpointState &state, int threads);
+
+class CheckpointFile
+{
+private:
+    std::string path;
+    int fd = -1;
+    CheckpointState state;
+    unsigned flags = 0;
+    int chunk_rows = 0;
+    std::vector<uint64_t> index; /**<Offset and size of each chunk*/
+
+public:
+    /**
+      Constructor, it reads and validates the header (size, states in [2, 256] and their encoding) and the chunk index
+      @param file_path checkpoint written by saveCheckpoint()
+     */
+    CheckpointFile(const std::string &file_path);
+    ~CheckpointFile();
+
+    CheckpointFile(const CheckpointFile &) = delete;
+    CheckpointFile &operator=(const CheckpointFile &) = delete;
+
+    const CheckpointState &getState() const { return state; }
+
+    /**
+     Method reading and decoding the chunks into grid, by threads threads
+     @param grid grid of the size in getState(), every cell is written
+     @param threads number of OpenMP threads
+    */
+    void load(FlatGrid &grid, int threads);
+};
+
+#endif
@@ -0,0 +1,48 @@
+/**
+    @brief Executors of the cellular automata engine.
+    An executor is the strategy running the timesteps of a CellularAutomata: sequential, std::thread, OpenMP, FastFlow
+    parallel for, FastFlow farm and so on. The engine keeps a registry of executors by name, so a backend is chosen at
+    run time (CellularAutomata::run("omp")) and new ones are added with CellularAutomata::registerExecutor(), without
+    touching the engine. Every executor sweeps the grid through the engine, so it gets the compiled rules, the
+    active tiles, the snapshots and the tracing of the engine.
+    @file executor.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <memory>
+#include <functional>
+#ifndef CA_EXECUTOR_H
+#define CA_EXECUTOR_H
+
+class CellularAutomata;
+
+class Executor
+{
+public:
+    virtual ~Executor() = default;
+
+    /**
+     Method running the timesteps of the automaton
+     @param automata automaton whose grid is advanced
+    */
+    virtual void run(CellularAutomata &automata) = 0;
+};
+
+/**
+ Executor calling a run method of the engine, used by the built-in backends
+*/
+class MethodExecutor : public Executor
+{
+private:
+    std::function<void(CellularAutomata &)> method;
+
+public:
+    MethodExecutor(std::function<void(CellularAutomata &)> m) : method(std::move(m)) {}
+    void run(CellularAutomata &automata) override { method(automata); }
+};
+
+//Creates an executor, each automaton creates its own the first time it runs it
+using ExecutorFactory = std::function<std::unique_ptr<Executor>()>;
+
+#endif
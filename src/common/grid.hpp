@@ -0,0 +1,334 @@
+/**
+    @brief Contiguous grid storage shared by the Cellular Automata engines.
+    The grid is kept in one aligned allocation whose rows are padded to a full cache line,
+    and the engines keep two of them (current and next generation) which are swapped by pointer
+    at the end of each timestep instead of deep copying a std::vector<std::vector<int>>.
+    A grid can also live in a memory-mapped file, so that it can be larger than the physical memory: the file starts with
+    a GRID_FILE_HEADER bytes header (magic, rows, columns, stride) followed by the padded rows, exactly as in memory.
+    @file grid.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifndef CA_GRID_H
+#define CA_GRID_H
+
+//Defining aliases
+using grid2D = std::vector<std::vector<int>>;
+
+#define GRID_ALIGNMENT 64                              /**<Alignment (in bytes) of the grid and of every row*/
+#define GRID_ROW_PAD (GRID_ALIGNMENT / (int)sizeof(int)) /**<Number of ints every row's stride is rounded to*/
+#define GRID_FILE_HEADER 4096                          /**<Bytes before the cells in a grid file, keeps the rows aligned*/
+#define GRID_FILE_MAGIC "CAGRID1"                      /**<First bytes of a grid file*/
+
+class FlatGrid
+{
+private:
+    int num_rows = 0, num_columns = 0, stride = 0; /**<Grid dimensions, stride is the padded row length*/
+    int *cells = nullptr;                          /**<Aligned storage of num_rows * stride cells*/
+    size_t mapped_bytes = 0;                       /**<Size of the file mapping holding the cells, 0 for heap grids*/
+
+    void allocate(int rows, int columns, bool zero = true)
+    {
+        num_rows = rows;
+        num_columns = columns;
+        stride = ((columns + GRID_ROW_PAD - 1) / GRID_ROW_PAD) * GRID_ROW_PAD;
+        size_t bytes = sizeof(int) * (size_t)num_rows * stride;
+        cells = bytes == 0 ? nullptr : (int *)std::aligned_alloc(GRID_ALIGNMENT, bytes);
+        if (bytes != 0 && zero)
+            std::memset(cells, 0, bytes);
+    }
+
+    //Maps the file at path, the cells follow the header. The file has to be GRID_FILE_HEADER + cell bytes long
+    void map(const std::string &path, int fd, size_t bytes)
+    {
+        void *base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED)
+        {
+            std::cerr << "Error: can't map the grid file " << path << std::endl;
+            exit(-1);
+        }
+        //The sweeps read the file front to back
+        madvise(base, bytes, MADV_SEQUENTIAL);
+        mapped_bytes = bytes;
+        cells = (int *)((char *)base + GRID_FILE_HEADER);
+    }
+
+    //Page-aligned range of the mapping holding the rows [a, b[, grown to whole pages (outer) or shrunk to them
+    bool pageRange(int a, int b, bool outer, char **begin, size_t *length) const
+    {
+        if (mapped_bytes == 0 || b <= a)
+            return false;
+        uintptr_t page = sysconf(_SC_PAGESIZE);
+        uintptr_t first = (uintptr_t)row(a), last = (uintptr_t)row(b);
+        first = outer ? first / page * page : (first + page - 1) / page * page;
+        last = outer ? (last + page - 1) / page * page : last / page * page;
+        if (last <= first)
+            return false;
+        *begin = (char *)first;
+        *length = last - first;
+        return true;
+    }
+
+public:
+    FlatGrid() {}
+
+    /**
+      Constructor, the cells are zero initialized
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+     */
+    FlatGrid(int rows, int columns) { allocate(rows, columns); }
+
+    /**
+      Constructor leaving the cells untouched, so that their pages can be placed by the threads writing them first
+      (see numa.hpp). Every row has to be written, e.g. with clearRows(), before it's read
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param zero whether the cells are zero initialized here
+     */
+    FlatGrid(int rows, int columns, bool zero) { allocate(rows, columns, zero); }
+
+    /**
+      Constructor creating a grid file, truncated if it exists, and mapping it. The cells are zero but the file is sparse,
+      so no page is read or written until it's used
+      @param path grid file
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+     */
+    FlatGrid(const std::string &path, int rows, int columns)
+    {
+        num_rows = rows;
+        num_columns = columns;
+        stride = ((columns + GRID_ROW_PAD - 1) / GRID_ROW_PAD) * GRID_ROW_PAD;
+        size_t bytes = GRID_FILE_HEADER + sizeof(int) * (size_t)num_rows * stride;
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, bytes) != 0)
+        {
+            std::cerr << "Error: can't create the grid file " << path << std::endl;
+            exit(-1);
+        }
+        map(path, fd, bytes);
+        char *header = (char *)cells - GRID_FILE_HEADER;
+        int32_t sizes[3] = {num_rows, num_columns, stride};
+        std::memcpy(header, GRID_FILE_MAGIC, sizeof(GRID_FILE_MAGIC));
+        std::memcpy(header + sizeof(GRID_FILE_MAGIC), sizes, sizeof(sizes));
+    }
+
+    /**
+      Constructor mapping an existing grid file, its cells are used in place without being copied to the heap
+      @param path grid file written by a mapped FlatGrid
+     */
+    explicit FlatGrid(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDWR);
+        char magic[sizeof(GRID_FILE_MAGIC)] = {0};
+        int32_t sizes[3] = {0, 0, 0};
+        struct stat info;
+        if (fd < 0 || pread(fd, magic, sizeof(magic), 0) != sizeof(magic) || std::memcmp(magic, GRID_FILE_MAGIC, sizeof(magic)) != 0 ||
+            pread(fd, sizes, sizeof(sizes), sizeof(magic)) != sizeof(sizes) || fstat(fd, &info) != 0 ||
+            sizes[0] <= 0 || sizes[1] <= 0 || sizes[2] < sizes[1] ||
+            (size_t)info.st_size != GRID_FILE_HEADER + sizeof(int) * (size_t)sizes[0] * sizes[2])
+        {
+            std::cerr << "Error: " << path << " isn't a grid file" << std::endl;
+            exit(-1);
+        }
+        num_rows = sizes[0];
+        num_columns = sizes[1];
+        stride = sizes[2];
+        map(path, fd, info.st_size);
+    }
+
+    /**
+      Constructor copying the content of a std::vector<std::vector<int>> grid
+      @param initial_state grid to copy, all the rows must have the same size
+     */
+    explicit FlatGrid(const grid2D &initial_state)
+    {
+        allocate(initial_state.size(), initial_state.empty() ? 0 : initial_state[0].size());
+        fromGrid2D(initial_state);
+    }
+
+    FlatGrid(const FlatGrid &other)
+    {
+        allocate(other.num_rows, other.num_columns);
+        if (cells != nullptr)
+            std::memcpy(cells, other.cells, sizeof(int) * (size_t)num_rows * stride);
+    }
+
+    FlatGrid(FlatGrid &&other) noexcept
+        : num_rows(other.num_rows), num_columns(other.num_columns), stride(other.stride), cells(other.cells), mapped_bytes(other.mapped_bytes)
+    {
+        other.cells = nullptr;
+        other.mapped_bytes = 0;
+    }
+
+    FlatGrid &operator=(FlatGrid other)
+    {
+        std::swap(num_rows, other.num_rows);
+        std::swap(num_columns, other.num_columns);
+        std::swap(stride, other.stride);
+        std::swap(cells, other.cells);
+        std::swap(mapped_bytes, other.mapped_bytes);
+        return *this;
+    }
+
+    ~FlatGrid()
+    {
+        if (mapped_bytes != 0)
+            munmap((char *)cells - GRID_FILE_HEADER, mapped_bytes);
+        else
+            std::free(cells);
+    }
+
+    /**
+     Row accessors
+     @param i row-index
+     @returns pointer to the first cell of the i-th row, rows are GRID_ALIGNMENT aligned
+    */
+    inline int *row(int i) { return cells + (size_t)i * stride; }
+    inline const int *row(int i) const { return cells + (size_t)i * stride; }
+
+    /**
+     Cell accessors
+     @param i row-index of the cell
+     @param j column-index of the cell
+    */
+    inline int &at(int i, int j) { return cells[(size_t)i * stride + j]; }
+    inline int at(int i, int j) const { return cells[(size_t)i * stride + j]; }
+
+    inline int *data() { return cells; }
+    inline const int *data() const { return cells; }
+    inline int getRows() const { return num_rows; }
+    inline int getColumns() const { return num_columns; }
+    inline int getStride() const { return stride; }
+    inline bool isMapped() const { return mapped_bytes != 0; }
+
+    /**
+     Read-ahead hint for a mapped grid: the rows [a, b[ are going to be used soon, so the kernel starts reading them
+    */
+    void prefetchRows(int a, int b) const
+    {
+        char *begin;
+        size_t length;
+        if (pageRange(a, b, true, &begin, &length))
+            madvise(begin, length, MADV_WILLNEED);
+    }
+
+    /**
+     Drop-behind hint for a mapped grid: the rows [a, b[ aren't needed for a while, their pages are unmapped and can be
+     reclaimed once written back. The content is kept, the file is read again on the next access.
+     Only the pages entirely inside the rows are released
+    */
+    void releaseRows(int a, int b) const
+    {
+        char *begin;
+        size_t length;
+        if (pageRange(a, b, false, &begin, &length))
+            madvise(begin, length, MADV_DONTNEED);
+    }
+
+    /**
+     Method writing the modified pages of a mapped grid back to its file
+    */
+    void sync() const
+    {
+        if (mapped_bytes != 0)
+            msync((char *)cells - GRID_FILE_HEADER, mapped_bytes, MS_SYNC);
+    }
+
+    /**
+     Method zeroing the rows [a, b[, padding included
+    */
+    void clearRows(int a, int b)
+    {
+        if (b > a)
+            std::memset(row(a), 0, sizeof(int) * (size_t)(b - a) * stride);
+    }
+
+    /**
+     Method used to build a std::vector<std::vector<int>> copy of the grid, used by the compatibility getters
+     @returns a deep copy of the grid
+    */
+    grid2D toGrid2D() const
+    {
+        grid2D copy(num_rows, std::vector<int>(num_columns));
+        for (int i = 0; i < num_rows; i++)
+            std::memcpy(copy[i].data(), row(i), sizeof(int) * num_columns);
+        return copy;
+    }
+
+    /**
+     Method used to overwrite the grid with the content of a std::vector<std::vector<int>> of the same dimensions
+     @param source grid to copy
+    */
+    void fromGrid2D(const grid2D &source)
+    {
+        for (int i = 0; i < num_rows; i++)
+            std::memcpy(row(i), source[i].data(), sizeof(int) * num_columns);
+    }
+};
+
+/**
+ Pair of FlatGrids holding the current and the next generation.
+ The engines read from current() and write into next(), then swap() exchanges the two pointers.
+*/
+class PingPongGrid
+{
+private:
+    FlatGrid buffers[2];          /**<The two generations*/
+    int current_index = 0;        /**<Index of the buffer holding the current generation*/
+
+public:
+    PingPongGrid() {}
+
+    PingPongGrid(int rows, int columns, bool zero = true)
+    {
+        buffers[0] = FlatGrid(rows, columns, zero);
+        buffers[1] = FlatGrid(rows, columns, zero);
+    }
+
+    /**
+      Constructor taking two grids of the same size, e.g. mapped ones
+      @param current_grid current generation
+      @param next_grid buffer of the next generation
+     */
+    PingPongGrid(FlatGrid &&current_grid, FlatGrid &&next_grid)
+    {
+        buffers[0] = std::move(current_grid);
+        buffers[1] = std::move(next_grid);
+    }
+
+    explicit PingPongGrid(const grid2D &initial_state)
+    {
+        buffers[0] = FlatGrid(initial_state);
+        buffers[1] = FlatGrid(buffers[0].getRows(), buffers[0].getColumns());
+    }
+
+    inline FlatGrid &current() { return buffers[current_index]; }
+    inline const FlatGrid &current() const { return buffers[current_index]; }
+    inline FlatGrid &next() { return buffers[current_index ^ 1]; }
+    inline const FlatGrid &next() const { return buffers[current_index ^ 1]; }
+
+    /**
+     Method called at the end of a timestep: the freshly computed generation becomes the current one
+    */
+    inline void swap() { current_index ^= 1; }
+
+    inline int getRows() const { return buffers[0].getRows(); }
+    inline int getColumns() const { return buffers[0].getColumns(); }
+};
+
+#endif
@@ -0,0 +1,394 @@
+#include "hashlife.hpp"
+#include <iostream>
+#include <algorithm>
+#include "utimer.cpp"
+
+/**
+    @brief Methods body of the hashlife.hpp file.
+    Nodes are referred by their index in the node store, since the store grows while the results are computed.
+    @file hashlife.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+HashLife::HashLife(int rows, int columns, int tsteps, const grid2D &initial_state, LifeLikeRule r, bool torus, size_t limit)
+{
+    num_rows = rows;
+    num_columns = columns;
+    timesteps = tsteps;
+    rule = r;
+    toroidal = torus;
+    memory_limit = limit;
+    if (toroidal && (rows != columns || rows < 2 || (rows & (rows - 1)) != 0))
+    {
+        std::cerr << "Error: toroidal HashLife needs a square grid whose side is a power of two" << std::endl;
+        exit(-1);
+    }
+    setGrid(initial_state);
+}
+
+void HashLife::setGrid(const grid2D &new_grid)
+{
+    nodes.clear();
+    empty_nodes.clear();
+    std::vector<uint32_t>(minimumSlots(), HASHLIFE_NONE).swap(slots);
+    hashed = 0;
+    //The two leaves
+    nodes.push_back(Node{0, 0, 0, 0, HASHLIFE_NONE, 0, 0, -1, false});
+    nodes.push_back(Node{0, 0, 0, 0, HASHLIFE_NONE, 1, 0, -1, false});
+
+    int level = 1;
+    while ((1 << level) < std::max(num_rows, num_columns))
+        level++;
+    root = build(new_grid, level, 0, 0);
+    torus_level = level;
+    shift = 0;
+    origin_y = origin_x = 0;
+    generation = 0;
+}
+
+//Hash of the four children
+static inline size_t hashChildren(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se)
+{
+    uint64_t h = nw * 0x9E3779B97F4A7C15ull;
+    h = (h ^ ne) * 0xC2B2AE3D27D4EB4Full;
+    h = (h ^ sw) * 0x165667B19E3779F9ull;
+    h = (h ^ se) * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+uint32_t HashLife::join(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se)
+{
+    size_t mask = slots.size() - 1;
+    size_t slot = hashChildren(nw, ne, sw, se) & mask;
+    while (slots[slot] != HASHLIFE_NONE)
+    {
+        const Node &n = nodes[slots[slot]];
+        if (n.nw == nw && n.ne == ne && n.sw == sw && n.se == se)
+            return slots[slot];
+        slot = (slot + 1) & mask;
+    }
+    return insert(nw, ne, sw, se, slot);
+}
+
+uint32_t HashLife::insert(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se, size_t slot)
+{
+    Node n;
+    n.nw = nw;
+    n.ne = ne;
+    n.sw = sw;
+    n.se = se;
+    n.result = HASHLIFE_NONE;
+    n.result_step = -1;
+    n.mark = false;
+    n.level = nodes[nw].level + 1;
+    n.population = nodes[nw].population + nodes[ne].population + nodes[sw].population + nodes[se].population;
+    uint32_t index = nodes.size();
+    nodes.push_back(n);
+    slots[slot] = index;
+    hashed++;
+    //Load factor kept under 1/2
+    if (hashed * 2 > slots.size())
+        rehash(slots.size() * 2);
+    return index;
+}
+
+size_t HashLife::minimumSlots()
+{
+    //At most a quarter of the limit, the table starts half empty
+    size_t size = HASHLIFE_MIN_SLOTS;
+    while (size < HASHLIFE_MAX_INITIAL_SLOTS && size * 2 * sizeof(uint32_t) <= memory_limit / 4)
+        size *= 2;
+    return size;
+}
+
+void HashLife::rehash(size_t size)
+{
+    //A new vector, so that a smaller table gives its memory back
+    std::vector<uint32_t>(size, HASHLIFE_NONE).swap(slots);
+    size_t mask = size - 1;
+    for (uint32_t i = 2; i < nodes.size(); i++)
+    {
+        const Node &n = nodes[i];
+        size_t slot = hashChildren(n.nw, n.ne, n.sw, n.se) & mask;
+        while (slots[slot] != HASHLIFE_NONE)
+            slot = (slot + 1) & mask;
+        slots[slot] = i;
+    }
+    hashed = nodes.size() - 2;
+}
+
+uint32_t HashLife::empty(int level)
+{
+    if (level == 0)
+        return 0;
+    while ((int)empty_nodes.size() <= level)
+        empty_nodes.push_back(HASHLIFE_NONE);
+    if (empty_nodes[level] == HASHLIFE_NONE)
+    {
+        uint32_t e = empty(level - 1);
+        empty_nodes[level] = join(e, e, e, e);
+    }
+    return empty_nodes[level];
+}
+
+uint32_t HashLife::centre(uint32_t n)
+{
+    Node c = nodes[n];
+    return join(nodes[c.nw].se, nodes[c.ne].sw, nodes[c.sw].ne, nodes[c.se].nw);
+}
+
+uint32_t HashLife::build(const grid2D &grid_, int level, int64_t y, int64_t x)
+{
+    //Squares outside the grid are empty
+    if (y >= num_rows || x >= num_columns)
+        return empty(level);
+    if (level == 0)
+        return grid_[y][x] != 0 ? 1 : 0;
+    int64_t half = (int64_t)1 << (level - 1);
+    uint32_t nw = build(grid_, level - 1, y, x);
+    uint32_t ne = build(grid_, level - 1, y, x + half);
+    uint32_t sw = build(grid_, level - 1, y + half, x);
+    uint32_t se = build(grid_, level - 1, y + half, x + half);
+    return join(nw, ne, sw, se);
+}
+
+uint32_t HashLife::expand(uint32_t n)
+{
+    //The node is placed in the centre of a node of the next level
+    Node c = nodes[n];
+    uint32_t e = empty(c.level - 1);
+    return join(join(e, e, e, c.nw), join(e, e, c.ne, e), join(e, c.sw, e, e), join(c.se, e, e, e));
+}
+
+uint32_t HashLife::baseResult(uint32_t n)
+{
+    //Level 2 node: the 4x4 cells are read and the centre 2x2 is advanced by one generation
+    int cells[4][4];
+    Node c = nodes[n];
+    uint32_t quadrants[4] = {c.nw, c.ne, c.sw, c.se};
+    for (int q = 0; q < 4; q++)
+    {
+        const Node &s = nodes[quadrants[q]];
+        int y = (q / 2) * 2, x = (q % 2) * 2;
+        cells[y][x] = s.nw;
+        cells[y][x + 1] = s.ne;
+        cells[y + 1][x] = s.sw;
+        cells[y + 1][x + 1] = s.se;
+    }
+    uint32_t next[4];
+    for (int k = 0; k < 4; k++)
+    {
+        int y = 1 + k / 2, x = 1 + k % 2, count = 0;
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++)
+                if (dy != 0 || dx != 0)
+                    count += cells[y + dy][x + dx];
+        unsigned mask = cells[y][x] ? rule.survive : rule.birth;
+        next[k] = (mask >> count) & 1;
+    }
+    return join(next[0], next[1], next[2], next[3]);
+}
+
+uint32_t HashLife::result(uint32_t n, int j)
+{
+    if (nodes[n].result != HASHLIFE_NONE && nodes[n].result_step == j)
+        return nodes[n].result;
+    Node c = nodes[n];
+    uint32_t r;
+    if (c.population == 0 && rule.birth % 2 == 0)
+        r = empty(c.level - 1); //Nothing is born from nothing (unless B0)
+    else if (c.level == 2)
+        r = baseResult(n);
+    else
+    {
+        //The 9 overlapping sub-squares of level L - 1
+        Node nw = nodes[c.nw], ne = nodes[c.ne], sw = nodes[c.sw], se = nodes[c.se];
+        uint32_t s[9] = {c.nw,
+                         join(nw.ne, ne.nw, nw.se, ne.sw),
+                         c.ne,
+                         join(nw.sw, nw.se, sw.nw, sw.ne),
+                         join(nw.se, ne.sw, sw.ne, se.nw),
+                         join(ne.sw, ne.se, se.nw, se.ne),
+                         c.sw,
+                         join(sw.ne, se.nw, sw.se, se.sw),
+                         c.se};
+        //Full speed: the sub-squares are advanced by 2^(j-1) twice, otherwise only the second time by 2^j
+        bool full = (j == c.level - 2);
+        for (int k = 0; k < 9; k++)
+            s[k] = full ? result(s[k], j - 1) : centre(s[k]);
+        int j2 = full ? j - 1 : j;
+        uint32_t a = result(join(s[0], s[1], s[3], s[4]), j2);
+        uint32_t b = result(join(s[1], s[2], s[4], s[5]), j2);
+        uint32_t d = result(join(s[3], s[4], s[6], s[7]), j2);
+        uint32_t e = result(join(s[4], s[5], s[7], s[8]), j2);
+        r = join(a, b, d, e);
+    }
+    nodes[n].result = r;
+    nodes[n].result_step = j;
+    return r;
+}
+
+void HashLife::step(int j)
+{
+    if (toroidal)
+    {
+        //The centre of the 2x2 tiling is the torus shifted by half of its side
+        uint32_t tiled = join(root, root, root, root);
+        root = result(tiled, j);
+        int64_t side = (int64_t)1 << torus_level;
+        shift = (shift + side / 2) % side;
+    }
+    else
+    {
+        //The pattern must lie in the centre of the centre, so it can't get out of the result in 2^j generations
+        while (nodes[root].level < j + 3)
+        {
+            int64_t half = (int64_t)1 << (nodes[root].level - 1);
+            root = expand(root);
+            origin_y -= half;
+            origin_x -= half;
+        }
+        while (nodes[root].population != nodes[centre(centre(root))].population)
+        {
+            int64_t half = (int64_t)1 << (nodes[root].level - 1);
+            root = expand(root);
+            origin_y -= half;
+            origin_x -= half;
+        }
+        int64_t quarter = (int64_t)1 << (nodes[root].level - 2);
+        root = result(root, j);
+        origin_y += quarter;
+        origin_x += quarter;
+    }
+    generation += (uint64_t)1 << j;
+}
+
+void HashLife::advance(uint64_t generations)
+{
+    while (generations > 0)
+    {
+        //Largest power of two allowed by the remaining generations, the torus and the memory pressure
+        int j = 63 - __builtin_clzll(generations);
+        if (toroidal)
+            j = std::min(j, torus_level - 1);
+        j = std::min(j, max_step);
+        step(j);
+        generations -= (uint64_t)1 << j;
+        checkMemory();
+    }
+}
+
+void HashLife::run()
+{
+    utimer thl("HashLife time:");
+    advance(timesteps);
+}
+
+void HashLife::checkMemory()
+{
+    if (getMemoryUsage() <= memory_limit)
+        return;
+    garbageCollect();
+    //If the live nodes alone are close to the limit the following steps are made shorter
+    if (getMemoryUsage() > memory_limit / 2 && max_step > 0)
+        max_step = std::max(0, std::min(max_step, (int)nodes[root].level) - 1);
+}
+
+void HashLife::garbageCollect()
+{
+    //Mark the nodes reachable from the root
+    for (Node &n : nodes)
+        n.mark = false;
+    nodes[0].mark = nodes[1].mark = true;
+    std::vector<uint32_t> stack(1, root);
+    while (!stack.empty())
+    {
+        uint32_t i = stack.back();
+        stack.pop_back();
+        if (nodes[i].mark)
+            continue;
+        nodes[i].mark = true;
+        stack.push_back(nodes[i].nw);
+        stack.push_back(nodes[i].ne);
+        stack.push_back(nodes[i].sw);
+        stack.push_back(nodes[i].se);
+    }
+
+    //Compact the store, then remap children and cached results
+    std::vector<uint32_t> remap(nodes.size(), HASHLIFE_NONE);
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < nodes.size(); i++)
+        if (nodes[i].mark)
+        {
+            remap[i] = kept;
+            nodes[kept++] = nodes[i];
+        }
+    nodes.resize(kept);
+    nodes.shrink_to_fit();
+    for (uint32_t i = 2; i < nodes.size(); i++)
+    {
+        Node &n = nodes[i];
+        n.nw = remap[n.nw];
+        n.ne = remap[n.ne];
+        n.sw = remap[n.sw];
+        n.se = remap[n.se];
+        if (n.result != HASHLIFE_NONE)
+            n.result = remap[n.result];
+        if (n.result == HASHLIFE_NONE)
+            n.result_step = -1;
+    }
+    root = remap[root];
+    empty_nodes.clear();
+
+    size_t size = minimumSlots();
+    while (size < nodes.size() * 2)
+        size *= 2;
+    rehash(size);
+}
+
+void HashLife::fill(uint32_t n, int64_t y, int64_t x, grid2D &out, int64_t rows, int64_t columns)
+{
+    const Node &c = nodes[n];
+    int64_t side = (int64_t)1 << c.level;
+    //Skip the empty squares and the ones outside the window
+    if (c.population == 0 || y >= rows || x >= columns || y + side <= 0 || x + side <= 0)
+        return;
+    if (c.level == 0)
+    {
+        out[y][x] = 1;
+        return;
+    }
+    int64_t half = side / 2;
+    uint32_t nw = c.nw, ne = c.ne, sw = c.sw, se = c.se;
+    fill(nw, y, x, out, rows, columns);
+    fill(ne, y, x + half, out, rows, columns);
+    fill(sw, y + half, x, out, rows, columns);
+    fill(se, y + half, x + half, out, rows, columns);
+}
+
+grid2D HashLife::getGrid()
+{
+    grid2D out(num_rows, std::vector<int>(num_columns, 0));
+    if (!toroidal)
+    {
+        fill(root, origin_y, origin_x, out, num_rows, num_columns);
+        return out;
+    }
+    //root[y][x] is torus[(y + shift) % side][(x + shift) % side]
+    int64_t side = (int64_t)1 << torus_level;
+    grid2D shifted(side, std::vector<int>(side, 0));
+    fill(root, 0, 0, shifted, side, side);
+    for (int64_t y = 0; y < side; y++)
+        for (int64_t x = 0; x < side; x++)
+            out[(y + shift) % side][(x + shift) % side] = shifted[y][x];
+    return out;
+}
+
+uint64_t HashLife::getGeneration() { return generation; }
+uint64_t HashLife::getPopulation() { return nodes[root].population; }
+size_t HashLife::getNodeCount() { return nodes.size(); }
+size_t HashLife::getMemoryUsage() { return nodes.capacity() * sizeof(Node) + slots.capacity() * sizeof(uint32_t); }
+int HashLife::getTimeSteps() { return timesteps; }
+void HashLife::setTimeSteps(int tsteps) { timesteps = tsteps; }
+void HashLife::setMemoryLimit(size_t bytes) { memory_limit = bytes; }
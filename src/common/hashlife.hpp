@@ -0,0 +1,132 @@
+/**
+    @brief HashLife engine for very long runs of 2-state life-like rules.
+    The grid is stored as a quadtree of canonical (hash-consed) nodes, so that identical regions are stored once,
+    and each node caches its centre advanced by 2^j generations. Regular patterns are then advanced
+    by large powers of two at a cost that doesn't depend on the number of cells.
+
+    Two boundary conditions are supported:
+    - toroidal, as the other engines: the grid must be a square whose side is a power of two.
+      The torus is tiled 2x2 and the centre of the tiling, advanced by 2^j generations, is the torus shifted by half its side.
+    - unbounded: the initial state is placed in an infinite plane and getGrid() returns the window [0, rows[ x [0, columns[.
+
+    The memory used by the nodes is bounded by a configurable soft limit, checked between steps: when it is exceeded at
+    the end of a step the unreachable nodes are collected, and if that isn't enough the following steps are made shorter.
+    A single step isn't interrupted, so it can go past the limit by the nodes it creates, and the nodes reachable from the
+    current state are never collected, so the limit can't go below them plus a hash table of HASHLIFE_MIN_SLOTS slots.
+    @file hashlife.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "grid.hpp"
+#include "bitlife.hpp"
+#ifndef CA_HASHLIFE_H
+#define CA_HASHLIFE_H
+
+#define HASHLIFE_NONE UINT32_MAX                        /**<Null node index*/
+#define HASHLIFE_DEFAULT_MEMORY ((size_t)1 << 30)       /**<Default memory limit, 1 GiB*/
+#define HASHLIFE_MIN_SLOTS 64                           /**<Smallest hash table*/
+#define HASHLIFE_MAX_INITIAL_SLOTS (1 << 16)            /**<Hash table of a new grid, when the limit allows it*/
+
+class HashLife
+{
+    //Quadtree node, level 0 nodes are the two cells (index 0 dead, index 1 alive)
+    struct Node
+    {
+        uint32_t nw, ne, sw, se; /**<Children, of level - 1*/
+        uint32_t result;         /**<Cached centre advanced by 2^result_step generations, HASHLIFE_NONE if missing*/
+        uint64_t population;     /**<Number of living cells*/
+        uint8_t level;           /**<The node covers 2^level x 2^level cells*/
+        int8_t result_step;      /**<Step of the cached result*/
+        bool mark;               /**<Used by the garbage collector*/
+    };
+
+private:
+    std::vector<Node> nodes;            /**<Node store, nodes are referred by index*/
+    std::vector<uint32_t> slots;        /**<Open addressing hash table of the nodes of level >= 1*/
+    size_t hashed = 0;                  /**<Number of nodes in the hash table*/
+    std::vector<uint32_t> empty_nodes;  /**<Cache of the empty node of each level*/
+
+    int num_rows, num_columns, timesteps; /**<Grid params*/
+    LifeLikeRule rule;                    /**<Update rule*/
+    bool toroidal;                        /**<Boundary condition*/
+    size_t memory_limit;                  /**<Soft limit on the memory used by nodes and hash table*/
+    int max_step = 62;                    /**<Largest exponent used for a single step, lowered under memory pressure*/
+
+    uint32_t root;                  /**<Toroidal: the torus (shifted by shift). Unbounded: the plane region at (origin_y, origin_x)*/
+    int torus_level = 0;            /**<Toroidal: log2 of the side*/
+    int64_t shift = 0;              /**<Toroidal: root[y][x] is torus[(y + shift) % side][(x + shift) % side]*/
+    int64_t origin_y = 0, origin_x = 0; /**<Unbounded: plane coordinates of the top left cell of root*/
+    uint64_t generation = 0;        /**<Number of generations computed*/
+
+    //Node construction
+    uint32_t join(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se);
+    uint32_t insert(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se, size_t slot);
+    void rehash(size_t size);
+    size_t minimumSlots();
+    uint32_t empty(int level);
+    uint32_t centre(uint32_t n);
+    uint32_t build(const grid2D &grid_, int level, int64_t y, int64_t x);
+    uint32_t expand(uint32_t n);
+
+    /**
+     Method computing the centre of the node advanced by 2^j generations
+     @param n node of level L >= 2
+     @param j step exponent, j <= L - 2
+     @returns the node of level L - 1 centred in n
+    */
+    uint32_t result(uint32_t n, int j);
+    uint32_t baseResult(uint32_t n);
+
+    void fill(uint32_t n, int64_t y, int64_t x, grid2D &out, int64_t rows, int64_t columns);
+    void step(int j);
+    void checkMemory();
+
+public:
+    /**
+      Constructor
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param tsteps number of generation executed by run()
+      @param initial_state initial grid, every non zero cell is considered alive
+      @param r life-like rule, Game of Life by default
+      @param torus true for the toroidal behaviour of the other engines (rows == columns == 2^k), false for an unbounded plane
+      @param memory_limit soft limit in bytes on the memory used by the nodes, checked between steps
+     */
+    HashLife(int rows, int columns, int tsteps, const grid2D &initial_state, LifeLikeRule r = GAME_OF_LIFE_B3S23,
+             bool torus = true, size_t memory_limit = HASHLIFE_DEFAULT_MEMORY);
+
+    /**
+     Method advancing the automaton by timesteps generations
+    */
+    void run();
+
+    /**
+     Method advancing the automaton by any number of generations, in steps of powers of two
+     @param generations number of generations
+    */
+    void advance(uint64_t generations);
+
+    /**
+     Method removing the nodes not reachable from the current state, the cached results pointing to them are dropped
+    */
+    void garbageCollect();
+
+    /**
+     Setter and Getter methods
+    */
+    grid2D getGrid();
+    void setGrid(const grid2D &new_grid);
+    uint64_t getGeneration();
+    uint64_t getPopulation();
+    size_t getNodeCount();
+    size_t getMemoryUsage();
+    int getTimeSteps();
+    void setTimeSteps(int tsteps);
+    void setMemoryLimit(size_t bytes);
+};
+
+#endif
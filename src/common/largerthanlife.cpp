@@ -0,0 +1,233 @@
+#include "largerthanlife.hpp"
+#include <iostream>
+#include <thread>
+#include <algorithm>
+#include <omp.h>
+#include "utimer.cpp"
+
+/**
+    @brief Methods body of the largerthanlife.hpp file.
+    A block of rows [a, b[ is copied in rows 1 .. (b - a + 2r) of the padded block, from row a - r to row b + r - 1, row 0
+    is zero. Each padded row holds the columns -(r + 1) .. columns + r, following a toroidal behaviour, between two
+    zero columns. The running sums of the alive cells are taken along the rows (left to right) and along the columns,
+    the diagonals and the anti-diagonals (top to bottom), so the sum over a straight segment is the difference of two of them.
+    @file largerthanlife.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+LargerThanLife::LargerThanLife(int rows, int columns, int tsteps, const grid2D &initial_state, int numthreads, const RadiusTotalisticRule &r)
+    : rule(r)
+{
+    num_rows = rows;
+    num_columns = columns;
+    timesteps = tsteps;
+    num_threads = numthreads;
+    int radius = rule.neighbourhood.getRadius();
+    margin = 1;
+    width = columns + 2 * (radius + 1) + 2 * margin;
+
+    //A cell enters the neighbourhood on the right edge, one column past the last one, and leaves it on the left edge
+    std::vector<int> right, left;
+    for (int di = -radius; di <= radius; di++)
+    {
+        right.push_back(rule.neighbourhood.last(di) + 1);
+        left.push_back(rule.neighbourhood.first(di));
+    }
+    entering = edgeSegments(right);
+    leaving = edgeSegments(left);
+
+    grid = PingPongGrid(rows, columns);
+    setGrid(initial_state);
+}
+
+std::vector<LargerThanLife::EdgeSegment> LargerThanLife::edgeSegments(const std::vector<int> &columns)
+{
+    std::vector<EdgeSegment> segments;
+    int radius = rule.neighbourhood.getRadius();
+    for (int k = 0; k < (int)columns.size();)
+    {
+        //A segment goes straight down, or down along a diagonal, a jump starts a new one
+        int step = k + 1 < (int)columns.size() ? columns[k + 1] - columns[k] : 0;
+        if (step < -1 || step > 1)
+            step = 0;
+        int end = k;
+        while (end + 1 < (int)columns.size() && columns[end + 1] - columns[end] == step)
+            end++;
+        segments.push_back(EdgeSegment{k - radius, end - radius, columns[k], step});
+        k = end + 1;
+    }
+    return segments;
+}
+
+void LargerThanLife::sweepBlock(int a, int b, Block &block)
+{
+    const FlatGrid &src = grid.current();
+    FlatGrid &dst = grid.next();
+    int radius = rule.neighbourhood.getRadius();
+    int padded_rows = b - a + 2 * radius + 1;
+    int offset = margin + radius + 1; //Padded column of the grid column 0
+    size_t cells = (size_t)padded_rows * width;
+    if (block.row_sums.size() < cells)
+    {
+        block.row_sums.resize(cells);
+        block.column_sums.resize(cells);
+        block.diagonal_sums.resize(cells);
+        block.antidiagonal_sums.resize(cells);
+    }
+    int *H = block.row_sums.data(), *V = block.column_sums.data(), *D = block.diagonal_sums.data(), *A = block.antidiagonal_sums.data();
+    std::fill(H, H + width, 0);
+    std::fill(V, V + width, 0);
+    std::fill(D, D + width, 0);
+    std::fill(A, A + width, 0);
+
+    //Copy of the rows and running sums
+    std::vector<int> alive(width, 0);
+    for (int p = 1; p < padded_rows; p++)
+    {
+        int g = ((a - radius + p - 1) % num_rows + num_rows) % num_rows;
+        const int *source = src.row(g);
+        for (int q = margin; q < width - margin; q++)
+        {
+            int column = q - offset;
+            if (column < 0 || column >= num_columns)
+                column = (column % num_columns + num_columns) % num_columns;
+            alive[q] = source[column] == 1;
+        }
+        int *h = H + (size_t)p * width, *v = V + (size_t)p * width, *d = D + (size_t)p * width, *an = A + (size_t)p * width;
+        const int *v_up = v - width, *d_up = d - width, *a_up = an - width;
+        h[0] = alive[0];
+        v[0] = v_up[0] + alive[0];
+        d[0] = alive[0];
+        an[0] = a_up[1] + alive[0];
+        for (int q = 1; q < width - 1; q++)
+        {
+            h[q] = h[q - 1] + alive[q];
+            v[q] = v_up[q] + alive[q];
+            d[q] = d_up[q - 1] + alive[q];
+            an[q] = a_up[q + 1] + alive[q];
+        }
+        int q = width - 1;
+        h[q] = h[q - 1] + alive[q];
+        v[q] = v_up[q] + alive[q];
+        d[q] = d_up[q - 1] + alive[q];
+        an[q] = alive[q];
+    }
+
+    //Sum of the cells (p0 + t, c0 + step * t) for t in [0, length[
+    auto segment = [&](int p0, int c0, int length, int step)
+    {
+        int p1 = p0 + length - 1, c1 = c0 + step * (length - 1);
+        if (step == 0)
+            return V[(size_t)p1 * width + c1] - V[(size_t)(p0 - 1) * width + c0];
+        if (step == 1)
+            return D[(size_t)p1 * width + c1] - D[(size_t)(p0 - 1) * width + c0 - 1];
+        return A[(size_t)p1 * width + c1] - A[(size_t)(p0 - 1) * width + c0 + 1];
+    };
+
+    for (int i = a; i < b; i++)
+    {
+        int pi = i - a + radius + 1;
+        const int *centre = src.row(i);
+        int *out = dst.row(i);
+        //Count of column 0 along the rows, then each column is obtained from the previous one
+        int count = 0;
+        for (int di = -radius; di <= radius; di++)
+        {
+            const int *h = H + (size_t)(pi + di) * width;
+            count += h[offset + rule.neighbourhood.last(di)] - h[offset + rule.neighbourhood.first(di) - 1];
+        }
+        for (int j = 0; j < num_columns; j++)
+        {
+            out[j] = rule.apply(centre[j], count - (!rule.count_centre && centre[j] == 1));
+            int q = j + offset;
+            for (const EdgeSegment &s : entering)
+                count += segment(pi + s.di_begin, q + s.column, s.di_end - s.di_begin + 1, s.step);
+            for (const EdgeSegment &s : leaving)
+                count -= segment(pi + s.di_begin, q + s.column, s.di_end - s.di_begin + 1, s.step);
+        }
+    }
+}
+
+void LargerThanLife::sweep(int a, int b, int id)
+{
+    //Blocks tall enough to amortize the halo of 2r rows
+    int block_rows = std::max(LTL_BLOCK_ROWS, 4 * (2 * rule.neighbourhood.getRadius() + 1));
+    for (int i = a; i < b; i += block_rows)
+        sweepBlock(i, std::min(b, i + block_rows), blocks[id]);
+}
+
+void LargerThanLife::sequentialRun()
+{
+    utimer tseq("Larger than Life sequential time:");
+    blocks.resize(std::max<size_t>(blocks.size(), 1));
+    for (int t = 0; t < timesteps; t++)
+    {
+        sweep(0, num_rows, 0);
+        grid.swap();
+    }
+}
+
+void LargerThanLife::threadsExecution()
+{
+    utimer tpar("Larger than Life thread execution time:");
+    if (!pool || pool->size() != num_threads)
+        pool = std::make_shared<WorkerPool>(num_threads);
+    blocks.resize(std::max<size_t>(blocks.size(), num_threads));
+    int delta = num_rows / num_threads;
+    int exceeded = num_rows % num_threads;
+    pool->run([this, delta, exceeded](int id)
+              {
+                  //The first (num_rows % num_threads) threads get one more row
+                  int start = id * delta + std::min(id, exceeded);
+                  exec(start, start + delta + (id < exceeded ? 1 : 0), id);
+              });
+}
+
+void LargerThanLife::exec(int a, int b, int id)
+{
+    for (int t = 0; t < timesteps; t++)
+    {
+        sweep(a, b, id);
+        //The last thread reaching the barrier makes the computed generation the current one
+        pool->sync([this]() { grid.swap(); });
+    }
+}
+
+void LargerThanLife::ompParallelFor()
+{
+    utimer my_timer("Larger than Life OpenMP parallel for time:");
+    blocks.resize(std::max<size_t>(blocks.size(), num_threads));
+    //One band per thread, each band is swept in blocks
+    for (int t = 0; t < timesteps; t++)
+    {
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+        for (int k = 0; k < num_threads; k++)
+            sweep((long)num_rows * k / num_threads, (long)num_rows * (k + 1) / num_threads, omp_get_thread_num());
+        grid.swap();
+    }
+}
+
+int LargerThanLife::naiveCount(int i, int j) const
+{
+    const FlatGrid &current = grid.current();
+    int radius = rule.neighbourhood.getRadius(), count = 0;
+    for (int di = -radius; di <= radius; di++)
+        for (int dj = rule.neighbourhood.first(di); dj <= rule.neighbourhood.last(di); dj++)
+        {
+            if (di == 0 && dj == 0 && !rule.count_centre)
+                continue;
+            int x = ((i + di) % num_rows + num_rows) % num_rows, y = ((j + dj) % num_columns + num_columns) % num_columns;
+            count += current.at(x, y) == 1;
+        }
+    return count;
+}
+
+grid2D LargerThanLife::getGrid() const { return grid.current().toGrid2D(); }
+void LargerThanLife::setGrid(const grid2D &new_grid) { grid.current().fromGrid2D(new_grid); }
+int LargerThanLife::getNumThreads() { return num_threads; }
+int LargerThanLife::getTimeSteps() { return timesteps; }
+void LargerThanLife::setNumThreads(int threads) { num_threads = threads; }
+void LargerThanLife::setWorkerPool(std::shared_ptr<WorkerPool> workers) { pool = workers; }
+std::shared_ptr<WorkerPool> LargerThanLife::getWorkerPool() { return pool; }
+void LargerThanLife::setTimeSteps(int tsteps) { timesteps = tsteps; }
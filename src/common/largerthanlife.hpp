@@ -0,0 +1,151 @@
+/**
+    @brief Engine for totalistic rules of any radius (Larger than Life).
+    The next state of a cell depends on its state and on how many cells of its neighbourhood are alive (state 1), with the
+    neighbourhood of any shape and radius (see neighbourhood.hpp). States follow the "Generations" convention of
+    totalistic.hpp, a cell in state k >= 2 is dying and doesn't count.
+    Counting the (2r + 1)^2 cells of each neighbourhood would cost O(r^2) per cell. Here every band of rows is copied,
+    with its halo, in a padded block where four running sums of the alive cells are built: along the rows, the columns,
+    the diagonals and the anti-diagonals. The count of a cell is then obtained from the one of the cell on its left,
+    adding the cells entering the neighbourhood and removing the ones leaving it: the right and left edges of the
+    neighbourhood are a few straight segments (one for MOORE, two for VON_NEUMANN and HEXAGONAL), and the sum over a
+    segment is the difference of two running sums. So each cell costs O(1) whatever the radius, plus the halo of the
+    blocks, LTL_BLOCK_ROWS rows tall at least.
+    @file largerthanlife.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <memory>
+#include "grid.hpp"
+#include "pool.hpp"
+#include "neighbourhood.hpp"
+#ifndef CA_LARGERTHANLIFE_H
+#define CA_LARGERTHANLIFE_H
+
+#define LTL_BLOCK_ROWS 128 /**<Minimum rows of the blocks the grid is swept in, the halo is amortized over them*/
+
+/**
+ Totalistic rule of any radius, in the notation of Larger than Life: Rr, Cstates, Mcentre, Sa..b, Ba..b, Nshape
+*/
+struct RadiusTotalisticRule
+{
+    Neighbourhood neighbourhood;  /**<Shape and radius*/
+    int states;                   /**<Number of states, 2 for life-like rules*/
+    int birth_min, birth_max;     /**<A cell in state 0 with a count in [birth_min, birth_max] becomes 1*/
+    int survive_min, survive_max; /**<A cell in state 1 with a count in [survive_min, survive_max] stays 1*/
+    bool count_centre;            /**<Whether the cell itself is part of its count*/
+
+    /**
+     Function applying the rule to a single cell
+     @param centre current state of the cell
+     @param count number of living cells of the neighbourhood
+     @returns next state of the cell
+    */
+    inline int apply(int centre, int count) const
+    {
+        if (centre == 0)
+            return count >= birth_min && count <= birth_max;
+        if (centre == 1)
+            return count >= survive_min && count <= survive_max ? 1 : (states > 2 ? 2 : 0);
+        return centre + 1 >= states ? 0 : centre + 1;
+    }
+};
+
+#define LIFE_RADIUS_RULE (RadiusTotalisticRule{Neighbourhood(MOORE, 1), 2, 3, 3, 2, 3, false})   /**<Game of Life, R1,C0,M0,S2..3,B3..3,NM*/
+#define BUGS_RULE (RadiusTotalisticRule{Neighbourhood(MOORE, 5), 2, 34, 45, 34, 58, true})       /**<Bosco's rule, R5,C0,M1,S34..58,B34..45,NM*/
+
+class LargerThanLife
+{
+private:
+    /**
+     Segment of an edge of the neighbourhood: the cells (di, column + step * (di - di_begin)) for di in [di_begin, di_end]
+    */
+    struct EdgeSegment
+    {
+        int di_begin, di_end, column, step;
+    };
+
+    /**
+     Padded copy of a block of rows and its running sums, one per thread
+    */
+    struct Block
+    {
+        std::vector<int> row_sums, column_sums, diagonal_sums, antidiagonal_sums;
+    };
+
+    PingPongGrid grid;                          /**<Current and next generation, swapped at each timestep*/
+    int num_rows, num_columns, num_threads;     /**<Grid and execution params*/
+    int timesteps;                              /**<Number of epochs*/
+    RadiusTotalisticRule rule;                  /**<Update rule*/
+    std::vector<EdgeSegment> entering, leaving; /**<Edges of the neighbourhood, see sweep()*/
+    std::vector<Block> blocks;                  /**<Scratch of each thread*/
+    int margin, width;                          /**<Zero columns on each side of a block and its width*/
+    std::shared_ptr<WorkerPool> pool;           /**<Threads used by threadsExecution(), kept across runs*/
+
+    /**
+     Method splitting an edge of the neighbourhood, given as a column per row offset, in straight segments
+    */
+    std::vector<EdgeSegment> edgeSegments(const std::vector<int> &columns);
+
+    /**
+     Method computing the next state of the rows [a, b[ from the current generation into the next one
+     @param a first row
+     @param b row after the last one
+     @param id index of the scratch block of the calling thread
+    */
+    void sweep(int a, int b, int id);
+
+    /**
+     Method computing a block of rows [a, b[, with b - a not larger than the block
+    */
+    void sweepBlock(int a, int b, Block &block);
+
+    /**
+     Method executed by the pool's threads in the threadsExecution() method.
+     @param a starting point of the interval
+     @param b ending point of the interval
+     @param id index of the thread
+    */
+    void exec(int a, int b, int id);
+
+public:
+    /**
+      Constructor
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param tsteps number of generation executed
+      @param initial_state initial grid
+      @param numthreads number of threads for the execution
+      @param r rule, its neighbourhood gives the shape and the radius
+     */
+    LargerThanLife(int rows, int columns, int tsteps, const grid2D &initial_state, int numthreads, const RadiusTotalisticRule &r = LIFE_RADIUS_RULE);
+
+    /**
+     Run methods, they follow the ones of CellularAutomata
+    */
+    void sequentialRun();
+    void threadsExecution();
+    void ompParallelFor();
+
+    /**
+     Method counting the living cells of the neighbourhood of a cell one by one, in O(r^2). It's the reference of the fast path
+     @param i row-index of the cell
+     @param j column-index of the cell
+    */
+    int naiveCount(int i, int j) const;
+
+    /**
+     Setter and Getter methods, the grid is converted from and to a std::vector<std::vector<int>>
+    */
+    grid2D getGrid() const;
+    void setGrid(const grid2D &new_grid);
+    int getNumThreads();
+    int getTimeSteps();
+    void setNumThreads(int threads);
+    void setWorkerPool(std::shared_ptr<WorkerPool> workers);
+    std::shared_ptr<WorkerPool> getWorkerPool();
+    void setTimeSteps(int tsteps);
+};
+
+#endif
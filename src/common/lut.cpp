@@ -0,0 +1,60 @@
+#include "lut.hpp"
+
+/**
+    @brief Methods body of the lut.hpp file.
+    @file lut.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+bool RuleTable::compile(int (*function)(neighbourhood), int n_states)
+{
+    if (function == compiled_rule && n_states == states)
+        return true;
+    if (function == nullptr || n_states < 2)
+        return false;
+
+    //Number of patterns, stopping as soon as the limit is exceeded
+    long patterns = 1;
+    for (int i = 0; i < NEIGHBOURHOOD_SIZE && patterns <= LUT_MAX_ENTRIES; i++)
+        patterns *= n_states;
+    if (patterns > LUT_MAX_ENTRIES)
+        return false;
+
+    std::vector<uint8_t> full(patterns);
+    std::vector<int> by_count(n_states * NEIGHBOURHOOD_SIZE, -1);
+    bool is_totalistic = true;
+    neighbourhood nb(NEIGHBOURHOOD_SIZE);
+    for (long key = 0; key < patterns; key++)
+    {
+        //Digit k (base n_states) of the key is the k-th cell of the neighbourhood
+        long rest = key;
+        int count = 0;
+        for (int i = 0; i < NEIGHBOURHOOD_SIZE; i++)
+        {
+            nb[i] = rest % n_states;
+            rest /= n_states;
+            if (i > 0 && nb[i] != 0)
+                count++;
+        }
+        int next = function(nb);
+        if (next < 0 || next >= n_states)
+            return false;
+        full[key] = next;
+
+        int &entry = by_count[nb[0] * NEIGHBOURHOOD_SIZE + count];
+        if (entry == -1)
+            entry = next;
+        else if (entry != next)
+            is_totalistic = false;
+    }
+
+    totalistic = is_totalistic;
+    if (totalistic)
+        table.assign(by_count.begin(), by_count.end());
+    else
+        table.swap(full);
+    compiled_rule = function;
+    states = n_states;
+    return true;
+}
@@ -0,0 +1,93 @@
+/**
+    @brief Lookup-table compilation of small-state rules.
+    A rule with few states is called once for every possible neighbourhood and the results are stored in a table,
+    the sweep then replaces the call to the rule with a table lookup.
+    If the probed rule turns out to depend only on the state of the cell and on the number of non-zero
+    neighbours (as the rules built on countDifferent(nb, 0)), the table is indexed by (centre, count),
+    otherwise by the whole 9-cell pattern (9 bits for 2-state rules).
+    The cells of the grid are assumed to be in [0, states[.
+    @file lut.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <cstdint>
+#include "stencil.hpp"
+#ifndef CA_LUT_H
+#define CA_LUT_H
+
+#define LUT_MAX_ENTRIES (1 << 18) /**<Largest pattern table compiled, i.e. rules with at most 4 states*/
+
+/**
+ Lookup functors, they are used with the templated run methods like any other rule
+*/
+struct TotalisticLookup
+{
+    const uint8_t *table; /**<states x (NEIGHBOURHOOD_SIZE) entries*/
+
+    inline int operator()(const NeighbourhoodView &nb) const
+    {
+        int count = 0;
+        for (int i = 1; i < NEIGHBOURHOOD_SIZE; i++)
+            count += (nb[i] != 0);
+        return table[nb[0] * NEIGHBOURHOOD_SIZE + count];
+    }
+};
+
+struct BinaryPatternLookup
+{
+    const uint8_t *table; /**<2^9 entries, bit k of the index is the k-th cell of the neighbourhood*/
+
+    inline int operator()(const NeighbourhoodView &nb) const
+    {
+        unsigned key = 0;
+        for (int i = 0; i < NEIGHBOURHOOD_SIZE; i++)
+            key |= (unsigned)nb[i] << i;
+        return table[key];
+    }
+};
+
+struct PatternLookup
+{
+    const uint8_t *table; /**<states^9 entries, digit k (base states) of the index is the k-th cell of the neighbourhood*/
+    int states;
+
+    inline int operator()(const NeighbourhoodView &nb) const
+    {
+        unsigned key = 0;
+        for (int i = NEIGHBOURHOOD_SIZE - 1; i >= 0; i--)
+            key = key * states + nb[i];
+        return table[key];
+    }
+};
+
+class RuleTable
+{
+private:
+    std::vector<uint8_t> table;                 /**<Compiled table*/
+    int (*compiled_rule)(neighbourhood) = nullptr; /**<Rule the table was compiled from*/
+    int states = 0;                             /**<Number of states the table was compiled for*/
+    bool totalistic = false;                    /**<Whether the table is indexed by (centre, count)*/
+
+public:
+    /**
+     Method probing the rule on every possible neighbourhood and building the table.
+     Nothing is done if the table was already compiled for the same rule and number of states.
+     @param function rule to compile
+     @param n_states number of states of the automaton
+     @returns false if the rule has too many states or returns values outside [0, n_states[, true otherwise
+    */
+    bool compile(int (*function)(neighbourhood), int n_states);
+
+    /**
+     Methods returning the lookup functor of the compiled table
+    */
+    inline bool isTotalistic() const { return totalistic; }
+    inline int getStates() const { return states; }
+    inline TotalisticLookup totalisticLookup() const { return TotalisticLookup{table.data()}; }
+    inline BinaryPatternLookup binaryLookup() const { return BinaryPatternLookup{table.data()}; }
+    inline PatternLookup patternLookup() const { return PatternLookup{table.data(), states}; }
+};
+
+#endif
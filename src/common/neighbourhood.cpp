@@ -0,0 +1,57 @@
+#include "neighbourhood.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+
+/**
+    @brief Methods body of the neighbourhood.hpp file.
+    @file neighbourhood.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+Neighbourhood::Neighbourhood(NeighbourhoodShape s, int r)
+{
+    if (r <= 0)
+    {
+        std::cerr << "Error: the radius of the neighbourhood must be strictly positive" << std::endl;
+        exit(-1);
+    }
+    shape = s;
+    radius = r;
+    for (int di = -r; di <= r; di++)
+    {
+        switch (shape)
+        {
+        case VON_NEUMANN:
+            first_column.push_back(-(r - std::abs(di)));
+            last_column.push_back(r - std::abs(di));
+            break;
+        case HEXAGONAL:
+            first_column.push_back(std::max(-r, -r - di));
+            last_column.push_back(std::min(r, r - di));
+            break;
+        default:
+            first_column.push_back(-r);
+            last_column.push_back(r);
+        }
+    }
+}
+
+int Neighbourhood::size() const
+{
+    int cells = 0;
+    for (int di = -radius; di <= radius; di++)
+        cells += last(di) - first(di) + 1;
+    return cells - 1;
+}
+
+std::vector<std::pair<int, int>> Neighbourhood::offsets() const
+{
+    std::vector<std::pair<int, int>> cells;
+    for (int di = -radius; di <= radius; di++)
+        for (int dj = first(di); dj <= last(di); dj++)
+            if (di != 0 || dj != 0)
+                cells.emplace_back(di, dj);
+    return cells;
+}
@@ -0,0 +1,58 @@
+/**
+    @brief Neighbourhoods of configurable shape and radius.
+    A neighbourhood is described row by row: for each row offset di in [-radius, radius] the cells at column offsets
+    [first(di), last(di)] belong to it, the cell itself (0, 0) included. The supported shapes are
+    - MOORE: the (2r + 1) x (2r + 1) square, radius 1 is the 3x3 neighbourhood of getNeighbourhood()
+    - VON_NEUMANN: the diamond |di| + |dj| <= r
+    - HEXAGONAL: the hexagon max(|di|, |dj|, |di + dj|) <= r of a hexagonal lattice stored with axial coordinates,
+      i.e. each row of the grid shifted by half a cell from the previous one, radius 1 has 6 neighbours
+    @file neighbourhood.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <utility>
+#ifndef CA_NEIGHBOURHOOD_H
+#define CA_NEIGHBOURHOOD_H
+
+enum NeighbourhoodShape
+{
+    MOORE,
+    VON_NEUMANN,
+    HEXAGONAL
+};
+
+class Neighbourhood
+{
+private:
+    NeighbourhoodShape shape;
+    int radius;
+    std::vector<int> first_column, last_column; /**<Column offsets of the row offset di, at index di + radius*/
+
+public:
+    /**
+     Constructor
+     @param s shape of the neighbourhood
+     @param r radius, strictly positive
+    */
+    Neighbourhood(NeighbourhoodShape s = MOORE, int r = 1);
+
+    inline int first(int di) const { return first_column[di + radius]; }
+    inline int last(int di) const { return last_column[di + radius]; }
+    inline int getRadius() const { return radius; }
+    inline NeighbourhoodShape getShape() const { return shape; }
+
+    /**
+     Method returning the number of neighbours, the cell itself excluded
+    */
+    int size() const;
+
+    /**
+     Method returning the (row, column) offsets of the neighbours, the cell itself excluded, row by row.
+     With MOORE and radius 1 they follow the order of getNeighbourhood()
+    */
+    std::vector<std::pair<int, int>> offsets() const;
+};
+
+#endif
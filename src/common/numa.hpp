@@ -0,0 +1,262 @@
+/**
+    @brief NUMA-aware placement of the grids and pinning of the threads.
+    Linux places a page on the NUMA node of the thread writing it first, so a grid filled by a single thread ends up
+    on one node and the threads running on the other nodes read remote memory. Here the grids are allocated untouched
+    and every thread writes the band of rows it computes, i.e. the same partition used by the run methods
+    (band i of n gets the rows [bandBegin(rows, n, i), bandBegin(rows, n, i + 1)[, like the OpenMP static schedule).
+    The threads can also be pinned: thread i of n always runs on the same CPU, and the threads are split in contiguous
+    groups over the nodes, so the bands of a node are adjacent and both the memory and the threads are spread over the nodes.
+    The topology is read from /sys/devices/system/node, without libnuma; a machine without it is a single node.
+    @file numa.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <omp.h>
+#include "grid.hpp"
+#ifndef CA_NUMA_H
+#define CA_NUMA_H
+
+#define PAGE_SAMPLES 4096 /**<Maximum number of pages looked up by the placement report*/
+
+/**
+ Method returning the first row of a band, the first (total % parts) bands get one more row
+ @param total number of rows
+ @param parts number of bands
+ @param index index of the band, index == parts gives total
+*/
+inline int bandBegin(int total, int parts, int index)
+{
+    return index * (total / parts) + std::min(index, total % parts);
+}
+
+class ThreadPlacement
+{
+private:
+    std::vector<std::vector<int>> node_cpus; /**<CPUs of each node usable by the process, nodes without CPUs are skipped*/
+    std::vector<int> node_ids;               /**<Id of each node in node_cpus*/
+    cpu_set_t allowed;                       /**<Affinity of the process at start-up, restored by unpin()*/
+
+    //Parses a sysfs cpulist, e.g. "0-3,8-11"
+    static std::vector<int> parseList(const std::string &list)
+    {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ','))
+        {
+            if (range.empty())
+                continue;
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    //The inverse of parseList(), used by the report
+    static std::string formatList(const std::vector<int> &cpus)
+    {
+        std::string list;
+        for (size_t i = 0; i < cpus.size();)
+        {
+            size_t j = i;
+            while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+                j++;
+            list += (list.empty() ? "" : ",") + std::to_string(cpus[i]) + (j > i ? "-" + std::to_string(cpus[j]) : "");
+            i = j + 1;
+        }
+        return list;
+    }
+
+    ThreadPlacement()
+    {
+        CPU_ZERO(&allowed);
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+        std::string list;
+        std::ifstream online("/sys/devices/system/node/online");
+        std::getline(online, list);
+        //Node ids can have holes, so the online ones are listed
+        for (int node : parseList(list))
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            list.clear();
+            std::getline(file, list);
+            std::vector<int> cpus;
+            for (int cpu : parseList(list))
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+                    cpus.push_back(cpu);
+            if (!cpus.empty())
+            {
+                node_cpus.push_back(cpus);
+                node_ids.push_back(node);
+            }
+        }
+        if (node_cpus.empty())
+        {
+            //No sysfs: a single node with every allowed CPU
+            node_cpus.emplace_back();
+            node_ids.push_back(0);
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                if (CPU_ISSET(cpu, &allowed))
+                    node_cpus[0].push_back(cpu);
+        }
+    }
+
+public:
+    ThreadPlacement(const ThreadPlacement &) = delete;
+    ThreadPlacement &operator=(const ThreadPlacement &) = delete;
+
+    /**
+     Method returning the topology of the machine, read once
+    */
+    static const ThreadPlacement &topology()
+    {
+        static ThreadPlacement instance;
+        return instance;
+    }
+
+    inline int getNodes() const { return node_cpus.size(); }
+
+    /**
+     Method returning the node (index in [0, getNodes()[) of thread id out of threads: the threads are split in
+     contiguous groups, one per node
+    */
+    inline int nodeOf(int id, int threads) const
+    {
+        return (long)id * node_cpus.size() / threads;
+    }
+
+    /**
+     Method returning the CPU of thread id out of threads. When there are more threads than CPUs in a node, the CPUs are reused
+    */
+    int cpuOf(int id, int threads) const
+    {
+        int node = nodeOf(id, threads);
+        //First thread of the node
+        int first = (node * threads + node_cpus.size() - 1) / node_cpus.size();
+        return node_cpus[node][(id - first) % node_cpus[node].size()];
+    }
+
+    /**
+     Method pinning the calling thread to the CPU of thread id out of threads
+     @returns whether the affinity was set
+    */
+    bool pin(int id, int threads) const
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpuOf(id, threads), &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    /**
+     Method giving the calling thread back the affinity the process had at start-up
+    */
+    void unpin() const
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(allowed), &allowed);
+    }
+
+    /**
+     Method counting the pages of a memory area on each node, looked up through move_pages(2) on at most PAGE_SAMPLES pages
+     @returns the count of pages per node index, empty if the pages can't be looked up
+    */
+    std::vector<long> pageNodes(const void *data, size_t bytes) const
+    {
+        long page = sysconf(_SC_PAGESIZE);
+        size_t count = (bytes + page - 1) / page, step = std::max<size_t>(1, count / PAGE_SAMPLES);
+        std::vector<void *> pages;
+        for (size_t p = 0; p < count; p += step)
+            pages.push_back((char *)data + p * page);
+        std::vector<int> status(pages.size());
+        std::vector<long> counts(node_cpus.size(), 0);
+#ifdef SYS_move_pages
+        if (pages.empty() || syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0)
+            return std::vector<long>();
+        for (int node : status)
+            for (size_t n = 0; n < node_ids.size(); n++)
+                if (node_ids[n] == node)
+                    counts[n]++;
+        return counts;
+#else
+        return std::vector<long>();
+#endif
+    }
+
+    /**
+     Method describing the nodes, where threads threads run and where the grid is
+     @param threads number of threads of the runs
+     @param pinned whether the threads are pinned
+     @param grid grid whose pages are looked up, nullptr to skip them
+    */
+    std::string report(int threads, bool pinned, const FlatGrid *grid = nullptr) const
+    {
+        std::string text = "NUMA nodes: " + std::to_string(node_cpus.size()) + "\n";
+        for (size_t n = 0; n < node_cpus.size(); n++)
+        {
+            int on_node = 0;
+            for (int id = 0; id < threads; id++)
+                on_node += nodeOf(id, threads) == (int)n;
+            text += "  node " + std::to_string(node_ids[n]) + ": cpus " + formatList(node_cpus[n]);
+            text += pinned ? ", " + std::to_string(on_node) + " pinned threads\n" : "\n";
+        }
+        if (!pinned)
+            text += "  " + std::to_string(threads) + " threads, not pinned\n";
+        if (grid != nullptr && grid->data() != nullptr)
+        {
+            std::vector<long> pages = pageNodes(grid->data(), sizeof(int) * (size_t)grid->getRows() * grid->getStride());
+            long total = 0;
+            for (long count : pages)
+                total += count;
+            if (total > 0)
+            {
+                text += "  grid pages:";
+                for (size_t n = 0; n < pages.size(); n++)
+                    text += " node " + std::to_string(node_ids[n]) + " " + std::to_string(100 * pages[n] / total) + "%";
+                text += "\n";
+            }
+        }
+        return text;
+    }
+};
+
+/**
+ Method allocating a pair of buffers whose pages are first touched by the threads computing them.
+ Thread i of threads writes the rows of band i of both buffers: fill(current, a, b) writes the rows [a, b[ of the
+ current generation, the next one is zeroed. With pin the OpenMP threads are pinned first, like the ones of the runs.
+ @param rows number of rows of the grid
+ @param columns number of columns of the grid
+ @param threads number of threads of the runs
+ @param pin whether the threads are pinned
+ @param fill callable writing rows of the current generation
+*/
+template <typename Fill>
+PingPongGrid placedGrid(int rows, int columns, int threads, bool pin, const Fill &fill)
+{
+    PingPongGrid grid(rows, columns, false);
+    const ThreadPlacement &placement = ThreadPlacement::topology();
+#pragma omp parallel num_threads(threads)
+    {
+        int id = omp_get_thread_num(), count = omp_get_num_threads();
+        if (pin)
+            placement.pin(id, count);
+        int a = bandBegin(rows, count, id), b = bandBegin(rows, count, id + 1);
+        fill(grid.current(), a, b);
+        grid.next().clearRows(a, b);
+    }
+    return grid;
+}
+
+#endif
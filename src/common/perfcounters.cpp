@@ -0,0 +1,151 @@
+#include "perfcounters.hpp"
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/**
+    @brief Methods body of the perfcounters.hpp file.
+    @file perfcounters.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+const char *PerfSample::name(int counter)
+{
+    static const char *names[PERF_COUNTERS] = {"cycles", "instructions", "llc_misses", "branch_misses", "dtlb_misses", "task_clock_ns"};
+    return names[counter];
+}
+
+void PerfSample::add(const PerfSample &other)
+{
+    for (int c = 0; c < PERF_COUNTERS; c++)
+    {
+        value[c] += other.value[c];
+        available[c] = available[c] && other.available[c];
+    }
+}
+
+//Type and configuration of each counter
+static void counterAttributes(int counter, perf_event_attr &attr)
+{
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (counter)
+    {
+    case PERF_CYCLES:
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PERF_INSTRUCTIONS:
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERF_LLC_MISSES:
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case PERF_BRANCH_MISSES:
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PERF_DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    default:
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.config = PERF_COUNT_SW_TASK_CLOCK;
+    }
+    attr.disabled = 1;
+    attr.inherit = 1; //threads created while counting are added when they exit
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+}
+
+//Threads of the process, the calling one first
+static std::vector<pid_t> processThreads()
+{
+    pid_t self = syscall(SYS_gettid);
+    std::vector<pid_t> threads = {self};
+    DIR *tasks = opendir("/proc/self/task");
+    if (tasks == nullptr)
+        return threads;
+    while (dirent *entry = readdir(tasks))
+    {
+        pid_t tid = std::atoi(entry->d_name);
+        if (tid > 0 && tid != self)
+            threads.push_back(tid);
+    }
+    closedir(tasks);
+    return threads;
+}
+
+PerfCounters::~PerfCounters() { close(); }
+
+void PerfCounters::close()
+{
+    for (int c = 0; c < PERF_COUNTERS; c++)
+    {
+        for (int fd : fds[c])
+            ::close(fd);
+        fds[c].clear();
+    }
+    running = false;
+}
+
+bool PerfCounters::start()
+{
+    close();
+    std::vector<pid_t> threads = processThreads();
+    bool any = false;
+    for (int c = 0; c < PERF_COUNTERS; c++)
+    {
+        perf_event_attr attr;
+        counterAttributes(c, attr);
+        for (size_t t = 0; t < threads.size(); t++)
+        {
+            int fd = syscall(SYS_perf_event_open, &attr, threads[t], -1, -1, 0);
+            //A counter refused on the calling thread is unavailable, another thread may just have exited
+            if (fd < 0 && t == 0)
+                break;
+            if (fd >= 0)
+                fds[c].push_back(fd);
+        }
+        any = any || !fds[c].empty();
+    }
+    for (int c = 0; c < PERF_COUNTERS; c++)
+        for (int fd : fds[c])
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    running = true;
+    return any;
+}
+
+PerfSample PerfCounters::stop()
+{
+    PerfSample sample;
+    if (!running)
+        return sample;
+    for (int c = 0; c < PERF_COUNTERS; c++)
+        for (int fd : fds[c])
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    for (int c = 0; c < PERF_COUNTERS; c++)
+    {
+        sample.available[c] = !fds[c].empty();
+        for (int fd : fds[c])
+        {
+            //Value, time enabled and time running
+            uint64_t counts[3] = {0, 0, 0};
+            if (read(fd, counts, sizeof(counts)) != sizeof(counts))
+            {
+                sample.available[c] = false;
+                continue;
+            }
+            //Scaled when the counter was multiplexed with others
+            double scale = counts[2] > 0 && counts[2] < counts[1] ? (double)counts[1] / counts[2] : 1.0;
+            sample.value[c] += counts[0] * scale;
+        }
+    }
+    close();
+    return sample;
+}
@@ -0,0 +1,74 @@
+/**
+    @brief Hardware performance counters of a run, read through perf_event_open.
+    start() opens the counters on every thread of the process (the worker pools and the OpenMP and FastFlow threads
+    created by previous runs) and on the threads they create later, stop() disables them and sums the counts of all the
+    threads. A counter the kernel refuses (no PMU in a virtual machine, perf_event_paranoid, seccomp) is marked as
+    unavailable and the others are still read, so the runs are never stopped by the counters.
+    The threads a run creates are counted once they exit, so the threads of a persistent pool have to exist before
+    start(), e.g. by means of a warm-up run. When the PMU is shared the counts are scaled by the time they were enabled.
+    @file perfcounters.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#ifndef CA_PERFCOUNTERS_H
+#define CA_PERFCOUNTERS_H
+
+enum PerfCounter
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_TASK_CLOCK, /**<CPU time of all the threads, in nanoseconds, a software counter available without a PMU*/
+    PERF_COUNTERS
+};
+
+/**
+ Counts of a run, a counter that couldn't be read has available set to false
+*/
+struct PerfSample
+{
+    double value[PERF_COUNTERS] = {0};
+    bool available[PERF_COUNTERS] = {false};
+
+    static const char *name(int counter);
+
+    /**
+     Method adding the counts of another run, a counter stays available only if it was in both
+    */
+    void add(const PerfSample &other);
+};
+
+class PerfCounters
+{
+private:
+    std::vector<int> fds[PERF_COUNTERS]; /**<Descriptors of each counter, one per thread*/
+    bool running = false;
+
+    void close();
+
+public:
+    PerfCounters() = default;
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /**
+     Method opening and enabling the counters on every thread of the process
+     @returns whether at least a counter is available
+    */
+    bool start();
+
+    /**
+     Method disabling the counters and summing them over the threads
+    */
+    PerfSample stop();
+};
+
+#endif
@@ -0,0 +1,187 @@
+/**
+    @brief Persistent worker pool used by the thread run methods.
+    The threads are created once and kept waiting between runs, so repeated runs don't pay the thread start-up.
+    Inside a run the workers synchronize through a sense-reversing barrier which spins for a while and then blocks:
+    the last thread reaching the barrier runs the completion (e.g. the buffer swap) and releases the others,
+    so no main thread sits between two barriers.
+    @file pool.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "numa.hpp"
+#ifndef CA_POOL_H
+#define CA_POOL_H
+
+#define BARRIER_SPINS 4096 /**<Number of checks a thread spins for before blocking on the barrier*/
+
+/**
+ Hint to the CPU that the thread is spinning
+*/
+static inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+class SenseBarrier
+{
+private:
+    int count;                   /**<Number of threads taking part to the barrier*/
+    std::atomic<int> remaining;  /**<Threads still missing in the current phase*/
+    std::atomic<int> sense{0};   /**<Flipped each time the barrier opens*/
+    int spins;                   /**<Spinning checks before blocking*/
+    std::mutex mutex;
+    std::condition_variable cv;
+
+public:
+    /**
+      Constructor
+      @param threads number of threads taking part to the barrier
+      @param spin_count number of checks a thread spins for before blocking
+     */
+    SenseBarrier(int threads, int spin_count = BARRIER_SPINS) : count(threads), remaining(threads), spins(spin_count) {}
+
+    /**
+     Method waiting for all the threads. The last one to arrive runs completion before opening the barrier,
+     so the other threads see its effects when they leave.
+     @param completion callable run by a single thread once per phase
+    */
+    template <typename Completion>
+    void wait(const Completion &completion)
+    {
+        //The sense can't flip before this thread arrives, so reading it here gives the current phase
+        int phase = sense.load(std::memory_order_acquire);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            completion();
+            remaining.store(count, std::memory_order_relaxed);
+            {
+                //The flip is made under the mutex so that a thread going to sleep can't miss it
+                std::lock_guard<std::mutex> lock(mutex);
+                sense.store(phase ^ 1, std::memory_order_release);
+            }
+            cv.notify_all();
+            return;
+        }
+        for (int i = 0; i < spins; i++)
+        {
+            if (sense.load(std::memory_order_acquire) != phase)
+                return;
+            cpuRelax();
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this, phase]() { return sense.load(std::memory_order_acquire) != phase; });
+    }
+
+    void wait()
+    {
+        wait([]() {});
+    }
+};
+
+/**
+ Generation counter published by a worker, used for point-to-point synchronization instead of a barrier.
+ It's padded to a cache line so that the counters of different workers don't interfere.
+*/
+struct alignas(64) GenerationCounter
+{
+    std::atomic<int> generation{0};
+
+    inline void publish(int g) { generation.store(g, std::memory_order_release); }
+
+    /**
+     Method waiting until the counter reaches g, spinning first and then yielding the CPU
+    */
+    inline void waitFor(int g) const
+    {
+        for (int i = 0; generation.load(std::memory_order_acquire) < g; i++)
+        {
+            if (i < BARRIER_SPINS)
+                cpuRelax();
+            else
+                std::this_thread::yield();
+        }
+    }
+};
+
+class WorkerPool
+{
+private:
+    std::vector<std::thread> workers;    /**<Persistent threads*/
+    SenseBarrier start, done;            /**<Used by run() to hand a job to the workers and wait for it, the caller takes part too*/
+    SenseBarrier step;                   /**<Barrier among the workers, used by the jobs*/
+    std::function<void(int)> job;        /**<Job of the current run*/
+    bool stop = false;                   /**<Set by the destructor*/
+    bool pinned;                         /**<Whether worker i is pinned to the CPU of thread i (see numa.hpp)*/
+    int num_workers;                     /**<Number of workers, read by them while the vector is still being filled*/
+
+    void loop(int id)
+    {
+        if (pinned)
+            ThreadPlacement::topology().pin(id, num_workers);
+        while (true)
+        {
+            start.wait();
+            if (stop)
+                return;
+            job(id);
+            done.wait();
+        }
+    }
+
+public:
+    /**
+      Constructor, the threads are started here and wait for run()
+      @param threads number of workers
+      @param pin whether each worker is pinned to a CPU
+     */
+    WorkerPool(int threads, bool pin = false) : start(threads + 1), done(threads + 1), step(threads), pinned(pin), num_workers(threads)
+    {
+        for (int i = 0; i < threads; i++)
+            workers.push_back(std::thread(&WorkerPool::loop, this, i));
+    }
+
+    ~WorkerPool()
+    {
+        stop = true;
+        start.wait();
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     Method running f(id) on every worker, id in [0, size()[, and waiting for all of them to return
+     @param f job of the workers
+    */
+    void run(std::function<void(int)> f)
+    {
+        job = std::move(f);
+        start.wait();
+        done.wait();
+    }
+
+    /**
+     Method used by the jobs to wait for the other workers, completion is run once by the last one arriving
+     @param completion callable run by a single worker
+    */
+    template <typename Completion>
+    void sync(const Completion &completion) { step.wait(completion); }
+
+    inline int size() const { return workers.size(); }
+    inline bool isPinned() const { return pinned; }
+};
+
+#endif
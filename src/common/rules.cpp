@@ -38,8 +38,18 @@ int gameOfLifeRule(neighbourhood nh)
     return nh[0];
 }
 
-
-
-
-
-
+bool totalisticEquivalent(int (*function)(neighbourhood), int n_states, OuterTotalisticRule *equivalent)
+{
+    OuterTotalisticRule found;
+    if (function == gameOfLifeRule)
+        found = GAME_OF_LIFE_RULE;
+    else if (function == brianbrain)
+        found = BRIAN_BRAIN_RULE;
+    else
+        return false;
+    //The kernel makes the states past the ones of the rule decay, the functions keep them
+    if (n_states > found.states)
+        return false;
+    *equivalent = found;
+    return true;
+}
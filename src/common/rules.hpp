@@ -0,0 +1,66 @@
+#ifndef RULES_H
+#define RULES_H
+#define NEIGHBOURHOOD_DIMENSION 8
+#include <vector>
+#include "stencil.hpp"
+#include "totalistic.hpp"
+using neighbourhood = std::vector<int>;
+using grid2D = std::vector<std::vector<int>>;
+
+int countDifferent(neighbourhood elems, int k);
+int countNonZero(neighbourhood elems);
+int brianbrain(neighbourhood nb);
+int gameOfLifeRule(neighbourhood nh);
+
+/**
+ Function used to know if a rule is one of the outer-totalistic rules above, which can be run by the vectorized kernels
+ @param function rule to look up
+ @param n_states number of states of the automaton, the equivalent only holds up to the states of the rule
+ @param equivalent filled with the outer-totalistic description of the rule, if any
+ @returns whether the rule has an outer-totalistic equivalent for n_states states
+*/
+bool totalisticEquivalent(int (*function)(neighbourhood), int n_states, OuterTotalisticRule *equivalent);
+
+/*
+ Functor versions of the rules above, to be used with the templated run methods.
+ They receive a NeighbourhoodView, so they don't allocate and get inlined in the sweep.
+*/
+
+inline int countDifferent(const NeighbourhoodView &elems, int k)
+{
+    int different = 0;
+    for (int i = 1; i < NEIGHBOURHOOD_SIZE; i++)
+        different += (elems[i] != k);
+    return different;
+}
+
+struct BrianBrain
+{
+    inline int operator()(const NeighbourhoodView &nb) const
+    {
+        int living_neighbour = countDifferent(nb, 0);
+        if (nb[0] == 0 && living_neighbour == 2)
+            return 1;
+        if (nb[0] == 1)
+            return 2;
+        if (nb[0] == 2)
+            return 0;
+        return nb[0];
+    }
+};
+
+struct GameOfLife
+{
+    inline int operator()(const NeighbourhoodView &nh) const
+    {
+        int living_neighbours = countDifferent(nh, 0);
+        if (living_neighbours < 2 || living_neighbours > 3)
+            return 0;
+        if (living_neighbours == 3 && nh[0] == 0)
+            return 1;
+        return nh[0];
+    }
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include "snapshot.hpp"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+
+/**
+    @brief Methods body of the snapshot.hpp file.
+    @file snapshot.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+void packRows(const int *cells, int stride, int columns, int a, int b, bool bits, uint8_t *out)
+{
+    size_t row_bytes = packedRowBytes(columns, bits);
+    for (int i = a; i < b; i++, out += row_bytes)
+    {
+        const int *row = cells + (size_t)i * stride;
+        if (!bits)
+        {
+            for (int j = 0; j < columns; j++)
+                out[j] = (uint8_t)row[j];
+            continue;
+        }
+        std::memset(out, 0, row_bytes);
+        for (int j = 0; j < columns; j++)
+            out[j >> 3] |= (uint8_t)((row[j] != 0) << (j & 7));
+    }
+}
+
+void unpackRows(const uint8_t *data, bool bits, FlatGrid &grid, int a, int b)
+{
+    int columns = grid.getColumns();
+    size_t row_bytes = packedRowBytes(columns, bits);
+    for (int i = a; i < b; i++, data += row_bytes)
+    {
+        int *row = grid.row(i);
+        for (int j = 0; j < columns; j++)
+            row[j] = bits ? (data[j >> 3] >> (j & 7)) & 1 : data[j];
+    }
+}
+
+void packBits(const uint8_t *data, size_t size, std::vector<uint8_t> &out)
+{
+    out.clear();
+    size_t i = 0;
+    while (i < size)
+    {
+        //Length of the run starting at i
+        size_t run = 1;
+        while (i + run < size && run < 130 && data[i + run] == data[i])
+            run++;
+        if (run >= 3)
+        {
+            out.push_back((uint8_t)(run + 125));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        //Literals, up to the next run of at least 3 bytes
+        size_t start = i, count = 0;
+        while (i < size && count < 128)
+        {
+            if (i + 2 < size && data[i] == data[i + 1] && data[i] == data[i + 2])
+                break;
+            i++;
+            count++;
+        }
+        out.push_back((uint8_t)(count - 1));
+        out.insert(out.end(), data + start, data + start + count);
+    }
+}
+
+void unpackBits(const uint8_t *data, size_t size, std::vector<uint8_t> &out)
+{
+    out.clear();
+    size_t i = 0;
+    while (i < size)
+    {
+        int c = data[i++];
+        if (c < 128)
+        {
+            out.insert(out.end(), data + i, data + std::min(size, i + c + 1));
+            i += c + 1;
+        }
+        else if (i < size)
+            out.insert(out.end(), c - 125, data[i++]);
+    }
+}
+
+SnapshotWriter::SnapshotWriter(const std::string &path, int rows, int columns, int n_states, int every, bool compress, int capacity)
+    : num_rows(rows), num_columns(columns), states(n_states), interval(every), queue(capacity)
+{
+    if (every <= 0 || capacity <= 0 || n_states > 256)
+    {
+        std::cerr << "Error: snapshots need a positive interval and queue, and at most 256 states" << std::endl;
+        exit(-1);
+    }
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        std::cerr << "Error: can't open the snapshot file " << path << std::endl;
+        exit(-1);
+    }
+    flags = (states <= 2 ? SNAPSHOT_BITS : 0) | (compress ? SNAPSHOT_RLE : 0);
+    uint32_t version = SNAPSHOT_VERSION;
+    int32_t header[3] = {rows, columns, states};
+    file.write("CASN", 4);
+    file.write((const char *)&version, sizeof(version));
+    file.write((const char *)header, sizeof(header));
+    file.write((const char *)&flags, sizeof(flags));
+    io = std::thread(&SnapshotWriter::loop, this);
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping.store(true);
+    }
+    cv.notify_one();
+    io.join();
+}
+
+void SnapshotWriter::shadowBuffer(FlatGrid &&buffer)
+{
+    if (buffer.getRows() != num_rows || buffer.getColumns() != num_columns)
+    {
+        std::cerr << "Error: the shadow buffer doesn't match the size of the snapshot file" << std::endl;
+        exit(-1);
+    }
+    spare = std::move(buffer);
+    shadow = true;
+}
+
+SnapshotFrame *SnapshotWriter::reserveFrame()
+{
+    SnapshotFrame *frame = queue.reserve();
+    //Every slot waits for the disk
+    for (int spins = 0; frame == nullptr; spins++)
+    {
+        if (spins >= SNAPSHOT_SPINS)
+            std::this_thread::yield();
+        frame = queue.reserve();
+    }
+    return frame;
+}
+
+void SnapshotWriter::pushFrame()
+{
+    queue.push();
+    {
+        //The lock orders the push with the check of an I/O thread going to sleep
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    cv.notify_one();
+}
+
+void SnapshotWriter::capture(const FlatGrid &grid, long generation)
+{
+    if (grid.getRows() != num_rows || grid.getColumns() != num_columns)
+    {
+        std::cerr << "Error: the grid doesn't match the size of the snapshot file" << std::endl;
+        exit(-1);
+    }
+    //The buffer of the previous frame can be written from now on
+    if (shadow && shared != nullptr)
+        settle();
+    auto start = std::chrono::steady_clock::now();
+    SnapshotFrame *frame = reserveFrame();
+    frame->generation = generation;
+    if (shadow)
+    {
+        //The I/O thread packs the cells, the buffer stays untouched until retire()
+        frame->source = grid.data();
+        frame->stride = grid.getStride();
+        shared = grid.data();
+        shared_frame = stalls.size() + 1;
+    }
+    else
+    {
+        frame->source = nullptr;
+        frame->data.resize(packedRowBytes(num_columns, flags & SNAPSHOT_BITS) * num_rows);
+        packRows(grid, 0, num_rows, flags & SNAPSHOT_BITS, frame->data.data());
+    }
+    pushFrame();
+    double waited = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    stalls.push_back(SnapshotStall{generation, waited});
+    stall += waited;
+}
+
+void SnapshotWriter::waitFrame(long n)
+{
+    if (n <= 0 || frames.load() >= n)
+        return;
+    auto start = std::chrono::steady_clock::now();
+    for (int spins = 0; frames.load() < n; spins++)
+        if (spins >= SNAPSHOT_SPINS)
+            std::this_thread::yield();
+    double waited = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    stalls[n - 1].stall += waited;
+    stall += waited;
+}
+
+bool SnapshotWriter::retire(FlatGrid &next)
+{
+    if (!shadow || shared == nullptr || next.data() != shared)
+        return false;
+    //The spare still holds an older frame until it's written
+    waitFrame(spare_frame);
+    std::swap(next, spare);
+    spare_frame = shared_frame;
+    shared = nullptr;
+    shared_frame = 0;
+    return true;
+}
+
+void SnapshotWriter::settle()
+{
+    waitFrame(shared_frame);
+    shared = nullptr;
+    shared_frame = 0;
+}
+
+void SnapshotWriter::flush()
+{
+    while (!queue.empty())
+        std::this_thread::yield();
+    //The last frame left the queue, wait until it's written too
+    std::lock_guard<std::mutex> lock(mutex);
+    file.flush();
+}
+
+void SnapshotWriter::loop()
+{
+    for (;;)
+    {
+        SnapshotFrame *frame = queue.front();
+        if (frame == nullptr)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]() { return !queue.empty() || stopping.load(); });
+            if (queue.empty())
+                break;
+            continue;
+        }
+        writeFrame(*frame);
+        //The mutex is held while the frame leaves the queue, so flush() can't return before it's written
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.pop();
+    }
+    file.flush();
+}
+
+void SnapshotWriter::writeFrame(SnapshotFrame &frame)
+{
+    if (frame.source != nullptr)
+    {
+        frame.data.resize(packedRowBytes(num_columns, flags & SNAPSHOT_BITS) * num_rows);
+        packRows(frame.source, frame.stride, num_columns, 0, num_rows, flags & SNAPSHOT_BITS, frame.data.data());
+    }
+    const std::vector<uint8_t> *payload = &frame.data;
+    if (flags & SNAPSHOT_RLE)
+    {
+        packBits(frame.data.data(), frame.data.size(), compressed);
+        payload = &compressed;
+    }
+    int64_t generation = frame.generation;
+    uint64_t size = payload->size();
+    file.write((const char *)&generation, sizeof(generation));
+    file.write((const char *)&size, sizeof(size));
+    file.write((const char *)payload->data(), size);
+    if (!file)
+    {
+        std::cerr << "Error: writing the snapshot of generation " << frame.generation << " failed" << std::endl;
+        exit(-1);
+    }
+    frames++;
+    bytes += sizeof(generation) + sizeof(size) + size;
+}
+
+SnapshotReader::SnapshotReader(const std::string &path) : file(path, std::ios::binary)
+{
+    char magic[4] = {0};
+    uint32_t version = 0;
+    int32_t header[3] = {0, 0, 0};
+    file.read(magic, 4);
+    file.read((char *)&version, sizeof(version));
+    file.read((char *)header, sizeof(header));
+    file.read((char *)&flags, sizeof(flags));
+    if (!file || std::memcmp(magic, "CASN", 4) != 0 || version != SNAPSHOT_VERSION)
+    {
+        std::cerr << "Error: " << path << " isn't a snapshot file" << std::endl;
+        exit(-1);
+    }
+    num_rows = header[0];
+    num_columns = header[1];
+    states = header[2];
+}
+
+bool SnapshotReader::next(long &generation, std::vector<std::vector<int>> &out)
+{
+    int64_t g;
+    uint64_t size;
+    if (!file.read((char *)&g, sizeof(g)) || !file.read((char *)&size, sizeof(size)))
+        return false;
+    payload.resize(size);
+    if (!file.read((char *)payload.data(), size))
+        return false;
+    const std::vector<uint8_t> *cells = &payload;
+    if (flags & SNAPSHOT_RLE)
+    {
+        unpackBits(payload.data(), payload.size(), packed);
+        cells = &packed;
+    }
+    size_t row_bytes = (flags & SNAPSHOT_BITS) ? (num_columns + 7) / 8 : num_columns;
+    if (cells->size() != row_bytes * num_rows)
+    {
+        std::cerr << "Error: corrupted snapshot of generation " << g << std::endl;
+        exit(-1);
+    }
+    generation = g;
+    out.assign(num_rows, std::vector<int>(num_columns));
+    for (int i = 0; i < num_rows; i++)
+    {
+        const uint8_t *row = cells->data() + i * row_bytes;
+        for (int j = 0; j < num_columns; j++)
+            out[i][j] = (flags & SNAPSHOT_BITS) ? (row[j >> 3] >> (j & 7)) & 1 : row[j];
+    }
+    return true;
+}
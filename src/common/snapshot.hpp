@@ -0,0 +1,247 @@
+/**
+    @brief Asynchronous writer of binary snapshots of the grid.
+    Every few generations the run methods hand the current generation to a SnapshotWriter: the calling thread packs it
+    (one byte per cell, or one bit per cell for the two-state automata) into a free slot of a bounded lock-free
+    single-producer single-consumer queue and goes on. A dedicated I/O thread takes the frames out of the queue, optionally
+    compresses them and writes them to the file, so the simulation only waits for the disk when every slot is full.
+    In shadow mode even the packing leaves the simulation: the frame only points to the buffer holding the generation, which
+    the I/O thread packs while the next generation is computed from it. When that buffer is about to be overwritten it's
+    exchanged with a spare one (retire()), so the simulation waits only if the spare is still being written.
+    File layout, in the byte order of the machine:
+      header: "CASN", uint32 version, int32 rows, int32 columns, int32 states, uint32 flags (SNAPSHOT_BITS, SNAPSHOT_RLE)
+      frame:  int64 generation, uint64 payload size, payload
+    The payload is row by row, each row padded to a byte when bit-packed, and PackBits compressed with SNAPSHOT_RLE.
+    @file snapshot.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <cstdint>
+#include "grid.hpp"
+#ifndef CA_SNAPSHOT_H
+#define CA_SNAPSHOT_H
+
+#define SNAPSHOT_VERSION 1      /**<Version of the file layout*/
+#define SNAPSHOT_BITS 1u        /**<Flag: one bit per cell instead of one byte*/
+#define SNAPSHOT_RLE 2u         /**<Flag: the payloads are PackBits compressed*/
+#define DEFAULT_SNAPSHOT_QUEUE 4 /**<Default number of frames which can wait for the I/O thread*/
+#define SNAPSHOT_SPINS 1024     /**<Checks the producer spins for on a full queue before yielding*/
+
+/**
+ A generation packed by the simulation and waiting to be written
+*/
+struct SnapshotFrame
+{
+    long generation;           /**<Generation of the grid*/
+    std::vector<uint8_t> data; /**<Packed cells, the buffer is reused by the following frames of the slot*/
+    const int *source;         /**<Shadow mode: cells packed by the I/O thread, nullptr when data is already packed*/
+    int stride;                /**<Row length of source*/
+};
+
+/**
+ Time the simulation waited because of a frame: packing it, a full queue, or the retirement of its buffer
+*/
+struct SnapshotStall
+{
+    long generation;
+    double stall; /**<Microseconds*/
+};
+
+class SnapshotQueue
+{
+private:
+    std::vector<SnapshotFrame> slots;           /**<Ring of frames, allocated once*/
+    alignas(64) std::atomic<size_t> head{0};    /**<Next frame to write, moved by the consumer only*/
+    alignas(64) std::atomic<size_t> tail{0};    /**<Next free slot, moved by the producer only*/
+
+public:
+    /**
+      Constructor
+      @param capacity maximum number of frames in the queue
+     */
+    SnapshotQueue(int capacity) : slots(capacity) {}
+
+    /**
+     Producer side: the free slot to fill, nullptr when the queue is full. The frame is visible to the consumer after push()
+    */
+    SnapshotFrame *reserve()
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == slots.size())
+            return nullptr;
+        return &slots[t % slots.size()];
+    }
+    void push() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    /**
+     Consumer side: the oldest frame, nullptr when the queue is empty. The slot goes back to the producer with pop()
+    */
+    SnapshotFrame *front()
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots[h % slots.size()];
+    }
+    void pop() { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+};
+
+class SnapshotWriter
+{
+private:
+    int num_rows, num_columns, states, interval; /**<Size of the grid and generations between two frames*/
+    unsigned flags;                              /**<SNAPSHOT_BITS and SNAPSHOT_RLE*/
+    std::ofstream file;
+    SnapshotQueue queue;
+    std::thread io;                              /**<Thread writing the frames*/
+    std::atomic<bool> stopping{false};
+    std::mutex mutex;                            /**<Only used to put the idle I/O thread to sleep*/
+    std::condition_variable cv;
+    std::vector<uint8_t> compressed;             /**<Scratch of the I/O thread*/
+    std::atomic<long> frames{0}, bytes{0};       /**<Frames and bytes written, updated by the I/O thread*/
+    double stall = 0;                            /**<Microseconds the simulation waited, all frames*/
+    std::vector<SnapshotStall> stalls;           /**<Wait of each frame, the n-th frame is stalls[n - 1]*/
+    bool shadow = false;                         /**<Whether the frames point to the grid instead of copying it*/
+    FlatGrid spare;                              /**<Shadow mode: buffer exchanged with the one being written*/
+    const int *shared = nullptr;                 /**<Shadow mode: buffer of the last frame, still used by the simulation*/
+    long shared_frame = 0, spare_frame = 0;      /**<Frames reading the shared and the spare buffer, 0 when none*/
+
+    //Body of the I/O thread
+    void loop();
+    void writeFrame(SnapshotFrame &frame);
+
+    //Free slot of the queue, waiting when it's full
+    SnapshotFrame *reserveFrame();
+    void pushFrame();
+
+    //Waits until the n-th frame is written, charging the wait to it
+    void waitFrame(long n);
+
+public:
+    /**
+      Constructor, it opens the file, writes the header and starts the I/O thread
+      @param path file the frames are written to, it's truncated
+      @param rows number of rows of the grid
+      @param columns number of columns of the grid
+      @param n_states number of states, at most 256. Two-state grids are bit-packed
+      @param every generations between two frames
+      @param compress whether the frames are run-length compressed
+      @param capacity frames which can wait for the I/O thread before the simulation stalls
+     */
+    SnapshotWriter(const std::string &path, int rows, int columns, int n_states, int every, bool compress = false, int capacity = DEFAULT_SNAPSHOT_QUEUE);
+
+    /**
+     Destructor, the frames in the queue are written before the file is closed
+    */
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    /**
+     Method enabling the shadow mode
+     @param buffer spare buffer of the size of the grid, e.g. placed like the grid (see numa.hpp)
+    */
+    void shadowBuffer(FlatGrid &&buffer);
+
+    /**
+     Method packing a generation into the queue, it waits only when the queue is full. Called by one thread at a time
+     @param grid grid holding the generation. It can be overwritten as soon as the method returns, in shadow mode
+     only after it went through retire() or settle()
+     @param generation number of the generation
+    */
+    void capture(const FlatGrid &grid, long generation);
+
+    /**
+     Shadow mode: method called with the buffer about to be overwritten. If it's the one of the last frame, it's exchanged
+     with the spare buffer, waiting for the frame of the spare to be written first
+     @param next buffer the simulation writes next
+     @returns whether the buffer was exchanged, its content is then the one of an older generation
+    */
+    bool retire(FlatGrid &next);
+
+    /**
+     Shadow mode: method waiting until the simulation can write any of its buffers, i.e. the last frame is written.
+     It's called when the buffers aren't used step by step, e.g. before a dependency-driven run
+    */
+    void settle();
+
+    /**
+     Method telling whether the generation completed after the steps [generation - steps, generation[ deserves a frame,
+     i.e. a multiple of the interval was reached. The run methods without a global step boundary call it with several steps.
+    */
+    bool due(long generation, int steps) const { return generation / interval > (generation - steps) / interval; }
+
+    /**
+     Method waiting until every captured frame is written to the file
+    */
+    void flush();
+
+    int getInterval() const { return interval; }
+    long getFrames() const { return frames.load(); }
+    long getBytes() const { return bytes.load(); }
+    double getStallTime() const { return stall; }
+    bool isShadow() const { return shadow; }
+
+    /**
+     Method returning the time the simulation waited for each frame
+    */
+    const std::vector<SnapshotStall> &getStalls() const { return stalls; }
+};
+
+class SnapshotReader
+{
+private:
+    std::ifstream file;
+    int num_rows = 0, num_columns = 0, states = 0;
+    unsigned flags = 0;
+    std::vector<uint8_t> payload, packed;
+
+public:
+    /**
+      Constructor, it reads the header
+      @param path file written by a SnapshotWriter
+     */
+    SnapshotReader(const std::string &path);
+
+    /**
+     Method reading the next frame
+     @param generation set to the generation of the frame
+     @param out set to the cells of the frame
+     @returns false at the end of the file
+    */
+    bool next(long &generation, std::vector<std::vector<int>> &out);
+
+    int getRows() const { return num_rows; }
+    int getColumns() const { return num_columns; }
+    int getStates() const { return states; }
+};
+
+/**
+ Packing of the rows [a, b[ of a grid: one bit per cell (nonzero cells are 1) or one byte per cell,
+ each row takes packedRowBytes() bytes
+*/
+inline size_t packedRowBytes(int columns, bool bits) { return bits ? (columns + 7) / 8 : columns; }
+void packRows(const int *cells, int stride, int columns, int a, int b, bool bits, uint8_t *out);
+inline void packRows(const FlatGrid &grid, int a, int b, bool bits, uint8_t *out)
+{
+    packRows(grid.data(), grid.getStride(), grid.getColumns(), a, b, bits, out);
+}
+void unpackRows(const uint8_t *data, bool bits, FlatGrid &grid, int a, int b);
+
+/**
+ PackBits run-length coding: a control byte c < 128 is followed by c + 1 literal bytes, c >= 128 by a byte repeated c - 125 times
+*/
+void packBits(const uint8_t *data, size_t size, std::vector<uint8_t> &out);
+void unpackBits(const uint8_t *data, size_t size, std::vector<uint8_t> &out);
+
+#endif
@@ -0,0 +1,165 @@
+/**
+    @brief Work-stealing scheduler of tiles.
+    At each step every worker gets a contiguous share of the tiles in its own deque: it takes them from the back,
+    and when the deque is empty it steals from the front of the other workers' deques. Rules with a data-dependent cost
+    (or the active-tile skipping) then keep all the workers busy until the end of the step.
+    The scheduler also records, for each worker, the time spent computing tiles and the time spent idle.
+    @file stealing.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include "pool.hpp"
+#ifndef CA_STEALING_H
+#define CA_STEALING_H
+
+#define DEFAULT_STEALING_TILE_ROWS 32     /**<Default tile rows of the work-stealing execution*/
+#define DEFAULT_STEALING_TILE_COLUMNS 256 /**<Default tile columns of the work-stealing execution*/
+
+/**
+ Balance statistics of a worker over a run, aligned so that the workers don't share cache lines while updating them
+*/
+struct alignas(64) WorkerStats
+{
+    double busy_usec = 0; /**<Time spent computing tiles*/
+    double idle_usec = 0; /**<Time spent looking for tiles and waiting at the end of the steps*/
+    long tiles = 0;       /**<Number of tiles computed*/
+    long steals = 0;      /**<Number of tiles taken from another worker*/
+};
+
+class StealingScheduler
+{
+    //Deque of tile indices, the owner works on the back and the thieves on the front. A spinlock is enough
+    //since the critical sections are a couple of instructions long
+    struct alignas(64) Deque
+    {
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        std::vector<int> items;
+        int head = 0, tail = 0;
+
+        inline void acquire()
+        {
+            while (lock.test_and_set(std::memory_order_acquire))
+                cpuRelax();
+        }
+        inline void release() { lock.clear(std::memory_order_release); }
+    };
+
+private:
+    std::unique_ptr<Deque[]> deques;  /**<One deque per worker*/
+    std::vector<WorkerStats> stats;   /**<One entry per worker*/
+    int num_workers = 0, num_tiles = 0;
+    std::atomic<int> remaining{0};    /**<Tiles of the current step not computed yet*/
+
+    static inline double elapsed(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return std::chrono::duration<double, std::micro>(to - from).count();
+    }
+
+    bool pop(int id, int &tile)
+    {
+        Deque &own = deques[id];
+        own.acquire();
+        bool found = own.head < own.tail;
+        if (found)
+            tile = own.items[--own.tail];
+        own.release();
+        return found;
+    }
+
+    bool steal(int id, int &tile)
+    {
+        for (int k = 1; k < num_workers; k++)
+        {
+            Deque &victim = deques[(id + k) % num_workers];
+            victim.acquire();
+            bool found = victim.head < victim.tail;
+            if (found)
+                tile = victim.items[victim.head++];
+            victim.release();
+            if (found)
+                return true;
+        }
+        return false;
+    }
+
+public:
+    /**
+     Method preparing a run, the statistics are cleared
+     @param workers number of workers
+     @param tiles number of tiles computed at each step
+    */
+    void configure(int workers, int tiles)
+    {
+        num_workers = workers;
+        num_tiles = tiles;
+        deques.reset(new Deque[workers]);
+        for (int i = 0; i < workers; i++)
+            deques[i].items.resize(tiles / workers + 1);
+        stats.assign(workers, WorkerStats());
+        remaining.store(tiles);
+    }
+
+    /**
+     Method called once all the workers finished a step (e.g. in the completion of the barrier)
+    */
+    void beginStep() { remaining.store(num_tiles, std::memory_order_relaxed); }
+
+    /**
+     Method computing the tiles of a step on the worker id: it fills its deque, then calls body(tile) on the tiles
+     taken from it or stolen from the others, and returns once every tile of the step is computed
+     @param id worker index
+     @param body callable computing a tile
+    */
+    template <typename Body>
+    void work(int id, const Body &body)
+    {
+        auto mark = std::chrono::steady_clock::now();
+        Deque &own = deques[id];
+        own.acquire();
+        own.head = 0;
+        own.tail = 0;
+        for (int k = (long)num_tiles * id / num_workers; k < (long)num_tiles * (id + 1) / num_workers; k++)
+            own.items[own.tail++] = k;
+        own.release();
+
+        WorkerStats &s = stats[id];
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            int tile;
+            bool stolen = false;
+            if (!pop(id, tile))
+            {
+                if (!steal(id, tile))
+                {
+                    //The last tiles are being computed by other workers
+                    std::this_thread::yield();
+                    continue;
+                }
+                stolen = true;
+            }
+            auto start = std::chrono::steady_clock::now();
+            s.idle_usec += elapsed(mark, start);
+            body(tile);
+            mark = std::chrono::steady_clock::now();
+            s.busy_usec += elapsed(start, mark);
+            s.tiles++;
+            s.steals += stolen;
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        s.idle_usec += elapsed(mark, std::chrono::steady_clock::now());
+    }
+
+    /**
+     Method adding idle time to a worker, used to account the barrier between the steps
+    */
+    void addIdle(int id, double usec) { stats[id].idle_usec += usec; }
+
+    const std::vector<WorkerStats> &getStats() const { return stats; }
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+    @brief Compile-time rule interface for the Cellular Automata engines.
+    A rule is any type providing int operator()(const NeighbourhoodView &) const.
+    The sweep below is templated on the rule type, so that the rule is inlined in the loop,
+    and gathers the neighbourhood into a fixed-size array living on the stack.
+    @file stencil.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include "grid.hpp"
+#ifndef CA_STENCIL_H
+#define CA_STENCIL_H
+
+#define NEIGHBOURHOOD_SIZE 9 /**<Moore neighbourhood plus the cell itself*/
+
+//Defining aliases
+using neighbourhood = std::vector<int>;
+
+/**
+ Fixed-size Moore neighbourhood. The layout is the same of getNeighbourhood():
+ the current state of the cell at index [0], then, starting from the top left corner, all the other neighbours
+ (upper left, upper, upper right, left, right, lower left, lower, lower right).
+*/
+struct NeighbourhoodView
+{
+    int cells[NEIGHBOURHOOD_SIZE];
+
+    inline int operator[](int i) const { return cells[i]; }
+    inline int size() const { return NEIGHBOURHOOD_SIZE; }
+    inline int centre() const { return cells[0]; }
+};
+
+/**
+ Adapter used to run the classic int (*)(neighbourhood) rules through the templated sweep.
+ The function still receives a std::vector<int>, so these rules keep paying an allocation per cell.
+*/
+struct FunctionRule
+{
+    int (*function)(neighbourhood); /**<Wrapped rule*/
+
+    inline int operator()(const NeighbourhoodView &nb) const
+    {
+        return function(neighbourhood(nb.cells, nb.cells + NEIGHBOURHOOD_SIZE));
+    }
+};
+
+/**
+ Function used to fill the neighbourhood of the cell at column j
+ @param nb neighbourhood to fill
+ @param up row above the cell
+ @param mid row of the cell
+ @param down row below the cell
+ @param l column on the left of the cell (already wrapped)
+ @param j column of the cell
+ @param r column on the right of the cell (already wrapped)
+*/
+inline void loadNeighbourhood(NeighbourhoodView &nb, const int *up, const int *mid, const int *down, int l, int j, int r)
+{
+    nb.cells[0] = mid[j];
+    nb.cells[1] = up[l];
+    nb.cells[2] = up[j];
+    nb.cells[3] = up[r];
+    nb.cells[4] = mid[l];
+    nb.cells[5] = mid[r];
+    nb.cells[6] = down[l];
+    nb.cells[7] = down[j];
+    nb.cells[8] = down[r];
+}
+
+/**
+ Function computing the next state of the cells in rows [row_begin, row_end[ and columns [column_begin, column_end[
+ following a toroidal behaviour
+ @param src grid holding the current generation
+ @param dst grid where the next generation is written
+ @param row_begin first row to compute
+ @param row_end row after the last one to compute
+ @param column_begin first column to compute
+ @param column_end column after the last one to compute
+ @param rule rule applied to every cell
+*/
+template <typename Rule>
+inline void stencilSweep(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, int column_begin, int column_end, const Rule &rule)
+{
+    int rows = src.getRows(), columns = src.getColumns();
+    NeighbourhoodView nb;
+    for (int i = row_begin; i < row_end; i++)
+    {
+        const int *up = src.row(i == 0 ? rows - 1 : i - 1);
+        const int *mid = src.row(i);
+        const int *down = src.row(i == rows - 1 ? 0 : i + 1);
+        int *out = dst.row(i);
+
+        //First and last columns wrap around, the inner ones don't need the toroidal checks
+        int j = column_begin;
+        if (j == 0 && j < column_end)
+        {
+            loadNeighbourhood(nb, up, mid, down, columns - 1, 0, columns > 1 ? 1 : 0);
+            out[0] = rule(nb);
+            j++;
+        }
+        int inner_end = column_end < columns - 1 ? column_end : columns - 1;
+        for (; j < inner_end; j++)
+        {
+            loadNeighbourhood(nb, up, mid, down, j - 1, j, j + 1);
+            out[j] = rule(nb);
+        }
+        if (j == columns - 1 && j < column_end)
+        {
+            loadNeighbourhood(nb, up, mid, down, columns - 2, columns - 1, 0);
+            out[columns - 1] = rule(nb);
+        }
+    }
+}
+
+/**
+ Function computing the next state of the rows [row_begin, row_end[ following a toroidal behaviour
+ @param src grid holding the current generation
+ @param dst grid where the next generation is written
+ @param row_begin first row to compute
+ @param row_end row after the last one to compute
+ @param rule rule applied to every cell
+*/
+template <typename Rule>
+inline void stencilSweep(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, const Rule &rule)
+{
+    stencilSweep(src, dst, row_begin, row_end, 0, src.getColumns(), rule);
+}
+
+#endif
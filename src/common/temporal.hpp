@@ -0,0 +1,103 @@
+/**
+    @brief Temporal blocking: several generations computed on a tile while it stays in cache.
+    A tile is loaded together with a halo of width depth (following a toroidal behaviour) into a small private
+    grid, advanced depth generations there and only its interior is written back. At each generation the valid
+    region shrinks by one cell on every side (trapezoidal tiling), so the halo cells are computed redundantly
+    by the neighbouring tiles instead of being exchanged: tiles are independent and the whole grid goes through
+    the memory once every depth generations instead of once per generation.
+    @file temporal.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <algorithm>
+#include <cstring>
+#include "grid.hpp"
+#include "stencil.hpp"
+#include "totalistic.hpp"
+#ifndef CA_TEMPORAL_H
+#define CA_TEMPORAL_H
+
+#define DEFAULT_TEMPORAL_DEPTH 8          /**<Default number of generations computed per pass*/
+#define DEFAULT_TEMPORAL_TILE_ROWS 128    /**<Default tile rows*/
+#define DEFAULT_TEMPORAL_TILE_COLUMNS 256 /**<Default tile columns, wide tiles keep the vectorized kernels busy*/
+
+/**
+ Scratch space of a worker: two private grids large enough for a tile plus its halo.
+ Each worker owns one, so that it's allocated (and first touched) by the thread using it.
+*/
+class TemporalBlock
+{
+private:
+    FlatGrid buffers[2]; /**<Ping-pong buffers of the tile*/
+    int depth;           /**<Halo width, i.e. maximum number of generations per pass*/
+
+    /**
+     Method copying columns [column_begin, column_begin + width[ of a source row, wrapping around the columns
+     @param source row of the grid
+     @param columns number of columns of the grid
+     @param column_begin first column, in [0, columns[
+     @param width number of cells to copy
+     @param out destination
+    */
+    static void loadRow(const int *source, int columns, int column_begin, int width, int *out)
+    {
+        int j = column_begin;
+        while (width > 0)
+        {
+            int n = std::min(width, columns - j);
+            std::memcpy(out, source + j, sizeof(int) * n);
+            out += n;
+            width -= n;
+            j = 0;
+        }
+    }
+
+public:
+    /**
+      Constructor
+      @param tile_rows maximum number of rows of a tile
+      @param tile_columns maximum number of columns of a tile
+      @param max_depth maximum number of generations per pass
+     */
+    TemporalBlock(int tile_rows, int tile_columns, int max_depth) : depth(max_depth)
+    {
+        buffers[0] = FlatGrid(tile_rows + 2 * depth, tile_columns + 2 * depth);
+        buffers[1] = FlatGrid(tile_rows + 2 * depth, tile_columns + 2 * depth);
+    }
+
+    /**
+     Method computing the tile [row_begin, row_end[ x [column_begin, column_end[ steps generations ahead
+     @param src grid holding the current generation
+     @param dst grid where the tile, steps generations later, is written
+     @param steps number of generations, at most the depth given to the constructor
+     @param rule rule applied to every cell
+    */
+    template <typename Rule>
+    void advance(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, int column_begin, int column_end, int steps, const Rule &rule)
+    {
+        int rows = src.getRows(), columns = src.getColumns();
+        int height = row_end - row_begin + 2 * steps, width = column_end - column_begin + 2 * steps;
+        //Positive modulo, the halo can wrap around more than once on small grids
+        int first_row = ((row_begin - steps) % rows + rows) % rows;
+        int first_column = ((column_begin - steps) % columns + columns) % columns;
+        for (int i = 0; i < height; i++)
+            loadRow(src.row((first_row + i) % rows), columns, first_column, width, buffers[0].row(i));
+
+        //Generation g is valid on [g, height - g[, its neighbours were all valid at generation g - 1.
+        //The local grids are never swept on their border, so stencilSweep never wraps around inside them
+        int current = 0;
+        for (int g = 1; g <= steps; g++)
+        {
+            stencilSweep(buffers[current], buffers[current ^ 1], g, height - g, g, width - g, rule);
+            current ^= 1;
+        }
+
+        //Only the interior goes back to memory
+        size_t bytes = sizeof(int) * (column_end - column_begin);
+        for (int i = row_begin; i < row_end; i++)
+            std::memcpy(dst.row(i) + column_begin, buffers[current].row(i - row_begin + steps) + steps, bytes);
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+/**
+    @brief Active-tile tracking, used to skip the stable or empty regions of the grid.
+    The grid is split in tiles and, for each of them, a flag records if it changed during the last step.
+    A tile is recomputed only if it or one of its 8 neighbour tiles (following a toroidal behaviour) changed,
+    otherwise its next state is its current one.
+    Skipping a tile leaves the next-generation buffer untouched, this is correct since a tile that didn't change
+    during the last step holds the same cells in both buffers. Every flag is set when tracking starts, so each tile
+    is computed at least once before being skipped.
+    @file tiles.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "grid.hpp"
+#include "stencil.hpp"
+#include "totalistic.hpp"
+#ifndef CA_TILES_H
+#define CA_TILES_H
+
+#define DEFAULT_TILE_SIDE 64 /**<Default tile side, in cells*/
+
+class ActiveTiles
+{
+private:
+    int tile_rows = 0, tile_columns = 0;   /**<Size of a tile, 0 if the tracking is disabled*/
+    int rows = 0, columns = 0;             /**<Grid size*/
+    int tiles_per_column = 0, tiles_per_row = 0; /**<Number of tiles along the rows and the columns*/
+    std::vector<uint8_t> changed;          /**<Tiles changed during the last step*/
+    std::vector<uint8_t> next_changed;     /**<Tiles changed during the current step, filled by the workers*/
+    std::vector<double> active_fractions;  /**<Fraction of tiles computed at each step*/
+
+public:
+    /**
+     Method enabling the tracking
+     @param grid_rows number of rows of the grid
+     @param grid_columns number of columns of the grid
+     @param t_rows number of rows of a tile, 0 disables the tracking
+     @param t_columns number of columns of a tile
+    */
+    void configure(int grid_rows, int grid_columns, int t_rows, int t_columns)
+    {
+        rows = grid_rows;
+        columns = grid_columns;
+        tile_rows = t_rows;
+        tile_columns = t_columns;
+        if (!enabled())
+            return;
+        tiles_per_column = (rows + tile_rows - 1) / tile_rows;
+        tiles_per_row = (columns + tile_columns - 1) / tile_columns;
+        reset();
+    }
+
+    /**
+     Method used when the grid size changes, the tile size is kept
+    */
+    void resize(int grid_rows, int grid_columns) { configure(grid_rows, grid_columns, tile_rows, tile_columns); }
+
+    /**
+     Method marking every tile as changed, it has to be called each time the grid is modified from outside a run
+    */
+    void reset()
+    {
+        changed.assign((size_t)tiles_per_column * tiles_per_row, 1);
+        next_changed.assign(changed.size(), 0);
+        active_fractions.clear();
+    }
+
+    /**
+     Method marking every tile as changed for the next step, without clearing the statistics. It's called when the
+     next-generation buffer is replaced by one holding another generation, so that every tile is rewritten
+    */
+    void invalidate() { std::fill(changed.begin(), changed.end(), 1); }
+
+    inline bool enabled() const { return tile_rows > 0 && tile_columns > 0; }
+    inline int getTileRows() const { return tiles_per_column; }
+    inline int getTileColumns() const { return tiles_per_row; }
+
+    /**
+     Method telling if a tile has to be computed in the current step
+     @param ti row-index of the tile
+     @param tj column-index of the tile
+    */
+    inline bool isActive(int ti, int tj) const
+    {
+        for (int di = -1; di <= 1; di++)
+        {
+            int i = (ti + di + tiles_per_column) % tiles_per_column;
+            for (int dj = -1; dj <= 1; dj++)
+                if (changed[(size_t)i * tiles_per_row + (tj + dj + tiles_per_row) % tiles_per_row])
+                    return true;
+        }
+        return false;
+    }
+
+    /**
+     Function computing the tile (ti, tj) if it's active, and recording whether it changed.
+     Each tile is written by a single worker, so different workers can sweep different tiles at the same time.
+     @param src grid holding the current generation
+     @param dst grid where the next generation is written
+     @param ti row-index of the tile
+     @param tj column-index of the tile
+     @param rule rule applied to every cell
+    */
+    template <typename Rule>
+    void sweepTile(const FlatGrid &src, FlatGrid &dst, int ti, int tj, const Rule &rule)
+    {
+        if (!isActive(ti, tj))
+            return;
+        int row_begin = ti * tile_rows, row_end = std::min(rows, row_begin + tile_rows);
+        int column_begin = tj * tile_columns, column_end = std::min(columns, column_begin + tile_columns);
+        stencilSweep(src, dst, row_begin, row_end, column_begin, column_end, rule);
+        //The tile changed if any of its rows differs from the current generation
+        bool tile_changed = false;
+        size_t bytes = sizeof(int) * (column_end - column_begin);
+        for (int i = row_begin; i < row_end && !tile_changed; i++)
+            tile_changed = std::memcmp(src.row(i) + column_begin, dst.row(i) + column_begin, bytes) != 0;
+        next_changed[(size_t)ti * tiles_per_row + tj] = tile_changed;
+    }
+
+    /**
+     Function computing the active tiles of the tile-rows [tile_row_begin, tile_row_end[
+     @param src grid holding the current generation
+     @param dst grid where the next generation is written
+     @param tile_row_begin first tile-row
+     @param tile_row_end tile-row after the last one
+     @param rule rule applied to every cell
+    */
+    template <typename Rule>
+    void sweep(const FlatGrid &src, FlatGrid &dst, int tile_row_begin, int tile_row_end, const Rule &rule)
+    {
+        for (int ti = tile_row_begin; ti < tile_row_end; ti++)
+            for (int tj = 0; tj < tiles_per_row; tj++)
+                sweepTile(src, dst, ti, tj, rule);
+    }
+
+    /**
+     Method called once every worker finished the step: records the active fraction and moves the flags forward
+    */
+    void endStep()
+    {
+        size_t active = 0;
+        for (int ti = 0; ti < tiles_per_column; ti++)
+            for (int tj = 0; tj < tiles_per_row; tj++)
+                active += isActive(ti, tj);
+        active_fractions.push_back((double)active / changed.size());
+        changed.swap(next_changed);
+        std::fill(next_changed.begin(), next_changed.end(), 0);
+    }
+
+    /**
+     Method returning the fraction of tiles computed at each step since the last reset
+    */
+    const std::vector<double> &getActiveFractions() const { return active_fractions; }
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "totalistic.hpp"
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CA_X86
+#endif
+
+/**
+    @brief Kernels declared in totalistic.hpp.
+    Each kernel computes the inner columns [begin, end[ of a row, where j - 1 and j + 1 never wrap around,
+    the border columns are left to the scalar code of stencilSweep.
+    @file totalistic.cpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+using rowKernel = void (*)(const int *up, const int *mid, const int *down, int *out, int begin, int end, const OuterTotalisticRule &rule);
+
+static inline int countNeighbours(const int *up, const int *mid, const int *down, int l, int j, int r)
+{
+    return (up[l] != 0) + (up[j] != 0) + (up[r] != 0) + (mid[l] != 0) + (mid[r] != 0) +
+           (down[l] != 0) + (down[j] != 0) + (down[r] != 0);
+}
+
+static void scalarRow(const int *up, const int *mid, const int *down, int *out, int begin, int end, const OuterTotalisticRule &rule)
+{
+    for (int j = begin; j < end; j++)
+        out[j] = rule.apply(mid[j], countNeighbours(up, mid, down, j - 1, j, j + 1));
+}
+
+#ifdef CA_X86
+
+__attribute__((target("avx2"))) static void avx2Row(const int *up, const int *mid, const int *down, int *out, int begin, int end, const OuterTotalisticRule &rule)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i eight = _mm256_set1_epi32(8);
+    const __m256i birth = _mm256_set1_epi32(rule.birth);
+    const __m256i survive = _mm256_set1_epi32(rule.survive);
+    const __m256i dying = _mm256_set1_epi32(rule.states > 2 ? 2 : 0);
+    const __m256i states = _mm256_set1_epi32(rule.states);
+    int j = begin;
+    for (; j + 8 <= end; j += 8)
+    {
+        //cmpeq gives -1 for every zero neighbour, so count = 8 - (number of zero neighbours)
+        __m256i zeros = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(up + j - 1)), zero);
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(up + j)), zero));
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(up + j + 1)), zero));
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(mid + j - 1)), zero));
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(mid + j + 1)), zero));
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(down + j - 1)), zero));
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(down + j)), zero));
+        zeros = _mm256_add_epi32(zeros, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(down + j + 1)), zero));
+        __m256i count = _mm256_add_epi32(eight, zeros);
+
+        __m256i centre = _mm256_loadu_si256((const __m256i *)(mid + j));
+        __m256i born = _mm256_and_si256(_mm256_srlv_epi32(birth, count), one);
+        __m256i survives = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srlv_epi32(survive, count), one), one);
+        __m256i alive = _mm256_blendv_epi8(dying, one, survives);
+        __m256i older = _mm256_add_epi32(centre, one);
+        older = _mm256_andnot_si256(_mm256_cmpgt_epi32(_mm256_add_epi32(older, one), states), older);
+
+        //Select the result following the state of the cell: 0 -> born, 1 -> alive, k -> older
+        __m256i result = _mm256_blendv_epi8(older, alive, _mm256_cmpeq_epi32(centre, one));
+        result = _mm256_blendv_epi8(result, born, _mm256_cmpeq_epi32(centre, zero));
+        _mm256_storeu_si256((__m256i *)(out + j), result);
+    }
+    scalarRow(up, mid, down, out, j, end, rule);
+}
+
+__attribute__((target("avx512f"))) static void avx512Row(const int *up, const int *mid, const int *down, int *out, int begin, int end, const OuterTotalisticRule &rule)
+{
+    const __m512i zero = _mm512_set1_epi32(0);
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i birth = _mm512_set1_epi32(rule.birth);
+    const __m512i survive = _mm512_set1_epi32(rule.survive);
+    const __m512i dying = _mm512_set1_epi32(rule.states > 2 ? 2 : 0);
+    const __m512i states = _mm512_set1_epi32(rule.states);
+    int j = begin;
+    for (; j + 16 <= end; j += 16)
+    {
+        //Each non zero neighbour adds one to its lane through a masked add
+        __m512i count = zero;
+        const int *neighbours[8] = {up + j - 1, up + j, up + j + 1, mid + j - 1, mid + j + 1, down + j - 1, down + j, down + j + 1};
+        for (int k = 0; k < 8; k++)
+            count = _mm512_mask_add_epi32(count, _mm512_test_epi32_mask(_mm512_loadu_si512(neighbours[k]), _mm512_set1_epi32(-1)), count, one);
+
+        __m512i centre = _mm512_loadu_si512(mid + j);
+        __m512i born = _mm512_and_si512(_mm512_srlv_epi32(birth, count), one);
+        __mmask16 survives = _mm512_test_epi32_mask(_mm512_srlv_epi32(survive, count), one);
+        __m512i alive = _mm512_mask_blend_epi32(survives, dying, one);
+        __m512i older = _mm512_add_epi32(centre, one);
+        older = _mm512_maskz_mov_epi32(_mm512_cmplt_epi32_mask(older, states), older);
+
+        //Select the result following the state of the cell: 0 -> born, 1 -> alive, k -> older
+        __m512i result = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(centre, one), older, alive);
+        result = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(centre, zero), result, born);
+        _mm512_storeu_si512(out + j, result);
+    }
+    scalarRow(up, mid, down, out, j, end, rule);
+}
+
+#endif
+
+/**
+ Function choosing the kernel once, following the instruction sets supported by the CPU.
+ The CA_KERNEL environment variable ("avx512", "avx2" or "scalar") can be used to restrict the choice.
+*/
+static rowKernel selectKernel(const char **name)
+{
+    const char *forced = std::getenv("CA_KERNEL");
+    bool any = (forced == nullptr);
+#ifdef CA_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && (any || std::strcmp(forced, "avx512") == 0))
+    {
+        *name = "avx512";
+        return avx512Row;
+    }
+    if (__builtin_cpu_supports("avx2") && (any || std::strcmp(forced, "avx512") == 0 || std::strcmp(forced, "avx2") == 0))
+    {
+        *name = "avx2";
+        return avx2Row;
+    }
+#endif
+    *name = "scalar";
+    return scalarRow;
+}
+
+static const char *kernel_name = nullptr;
+static const rowKernel kernel = selectKernel(&kernel_name);
+
+const char *totalisticKernelName() { return kernel_name; }
+
+void stencilSweep(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, const OuterTotalistic &rule)
+{
+    stencilSweep(src, dst, row_begin, row_end, 0, src.getColumns(), rule);
+}
+
+void stencilSweep(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, int column_begin, int column_end, const OuterTotalistic &rule)
+{
+    int rows = src.getRows(), columns = src.getColumns();
+    const OuterTotalisticRule &r = rule.rule;
+    //Inner columns, the ones whose neighbours don't wrap around
+    int inner_begin = column_begin > 1 ? column_begin : 1;
+    int inner_end = column_end < columns - 1 ? column_end : columns - 1;
+    for (int i = row_begin; i < row_end; i++)
+    {
+        const int *up = src.row(i == 0 ? rows - 1 : i - 1);
+        const int *mid = src.row(i);
+        const int *down = src.row(i == rows - 1 ? 0 : i + 1);
+        int *out = dst.row(i);
+
+        //First and last columns wrap around, the inner ones go through the vectorized kernel
+        if (column_begin == 0)
+            out[0] = r.apply(mid[0], countNeighbours(up, mid, down, columns - 1, 0, columns > 1 ? 1 : 0));
+        if (inner_begin < inner_end)
+            kernel(up, mid, down, out, inner_begin, inner_end, r);
+        if (columns > 1 && column_end == columns)
+            out[columns - 1] = r.apply(mid[columns - 1], countNeighbours(up, mid, down, columns - 2, columns - 1, 0));
+    }
+}
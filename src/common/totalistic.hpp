@@ -0,0 +1,84 @@
+/**
+    @brief Outer-totalistic rules and their vectorized kernels.
+    In an outer-totalistic rule the next state only depends on the state of the cell and on the number
+    of non-zero neighbours. States follow the "Generations" convention:
+    - a cell in state 0 becomes 1 if the bit (count) of birth is set, otherwise it stays 0
+    - a cell in state 1 stays 1 if the bit (count) of survive is set, otherwise it starts dying (state 2, or 0 with 2 states)
+    - a cell in state k >= 2 goes to k + 1, and back to 0 after the last state
+    gameOfLifeRule is {2, B3, S23} and brianbrain is {3, B2, S}.
+    The sweep counts the neighbours of a whole vector of cells at once (AVX-512 or AVX2, chosen at runtime)
+    and falls back to a scalar loop when neither is available.
+    @file totalistic.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include "grid.hpp"
+#include "stencil.hpp"
+#ifndef CA_TOTALISTIC_H
+#define CA_TOTALISTIC_H
+
+struct OuterTotalisticRule
+{
+    int states;       /**<Number of states*/
+    unsigned birth;   /**<Bit k set if a cell in state 0 with k living neighbours becomes 1*/
+    unsigned survive; /**<Bit k set if a cell in state 1 with k living neighbours stays 1*/
+
+    /**
+     Function applying the rule to a single cell
+     @param centre current state of the cell
+     @param count number of non-zero neighbours
+     @returns next state of the cell
+    */
+    inline int apply(int centre, int count) const
+    {
+        if (centre == 0)
+            return (birth >> count) & 1;
+        if (centre == 1)
+            return ((survive >> count) & 1) ? 1 : (states > 2 ? 2 : 0);
+        return centre + 1 >= states ? 0 : centre + 1;
+    }
+};
+
+#define GAME_OF_LIFE_RULE (OuterTotalisticRule{2, 1u << 3, (1u << 2) | (1u << 3)}) /**<Same as gameOfLifeRule*/
+#define BRIAN_BRAIN_RULE (OuterTotalisticRule{3, 1u << 2, 0u})                      /**<Same as brianbrain*/
+
+/**
+ Functor used to run an outer-totalistic rule through the templated run methods.
+ The stencilSweep overload below takes over, so every backend uses the vectorized kernel.
+*/
+struct OuterTotalistic
+{
+    OuterTotalisticRule rule;
+
+    inline int operator()(const NeighbourhoodView &nb) const
+    {
+        int count = 0;
+        for (int i = 1; i < NEIGHBOURHOOD_SIZE; i++)
+            count += (nb[i] != 0);
+        return rule.apply(nb[0], count);
+    }
+};
+
+/**
+ Function computing the next state of the rows [row_begin, row_end[ with the best kernel available on the machine
+ @param src grid holding the current generation
+ @param dst grid where the next generation is written
+ @param row_begin first row to compute
+ @param row_end row after the last one to compute
+ @param rule outer-totalistic rule applied to every cell
+*/
+void stencilSweep(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, const OuterTotalistic &rule);
+
+/**
+ Same as above, restricted to the columns [column_begin, column_end[
+*/
+void stencilSweep(const FlatGrid &src, FlatGrid &dst, int row_begin, int row_end, int column_begin, int column_end, const OuterTotalistic &rule);
+
+/**
+ Function used to know which kernel has been selected at runtime
+ @returns "avx512", "avx2" or "scalar"
+*/
+const char *totalisticKernelName();
+
+#endif
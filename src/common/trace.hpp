@@ -0,0 +1,236 @@
+/**
+    @brief Per-thread instrumentation of the run methods.
+    Each thread taking part to a run (a lane) records, for every generation, the time it spends computing cells, waiting
+    for the other threads and swapping the buffers (or copying and releasing them). The events go in per-lane buffers
+    allocated when the run starts, so recording is two reads of the steady clock and a store, without locks or
+    allocations. Consecutive compute events of the same generation are merged into one, and the gaps between them
+    (e.g. while a worker takes its next chunk) count as waiting.
+    The instrumentation is compiled only with CA_TRACE defined (make TRACE=1): otherwise the TRACE_ macros used by the
+    run methods expand to nothing. The trace of the last run is written as a Chrome trace (chrome://tracing, Perfetto)
+    or summarized in a table.
+    @file trace.hpp
+    @author Andrea Zuppolini
+    @version 2 17/10/2026
+*/
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#ifndef CA_TRACE_H
+#define CA_TRACE_H
+
+#define TRACE_EVENTS_PER_STEP 8 /**<Events a lane can record per generation, unless the run asks for more*/
+#define TRACE_MAIN -1           /**<Lane of the thread running the method, as opposed to the workers*/
+
+enum TraceKind : uint8_t
+{
+    TRACE_COMPUTE,
+    TRACE_WAIT,
+    TRACE_SWAP
+};
+
+struct TraceEvent
+{
+    uint64_t begin, end; /**<Steady clock, in nanoseconds*/
+    uint64_t busy;       /**<Time spent in the merged events, end - begin if nothing was merged*/
+    int32_t generation;  /**<Step of the run*/
+    TraceKind kind;
+};
+
+class Tracer
+{
+private:
+    //Lanes are written by different threads, so each one starts on its own cache line
+    struct alignas(64) Lane
+    {
+        std::vector<TraceEvent> events;
+        size_t size = 0;
+        long dropped = 0; /**<Events not recorded because the buffer was full*/
+    };
+
+    std::string name;        /**<Run method of the last run*/
+    std::vector<Lane> lanes; /**<One per worker, then the main one*/
+    uint64_t origin = 0;     /**<Start of the run*/
+
+    inline Lane &lane(int id) { return lanes[id == TRACE_MAIN ? lanes.size() - 1 : id]; }
+
+public:
+    static inline uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     Method starting the trace of a run, the previous one is dropped
+     @param run name of the run method
+     @param workers number of worker lanes, the main lane is added to them
+     @param events events each lane can record
+    */
+    void begin(const std::string &run, int workers, size_t events)
+    {
+        name = run;
+        lanes = std::vector<Lane>(workers + 1);
+        for (Lane &l : lanes)
+            l.events.resize(events);
+        origin = now();
+    }
+
+    /**
+     Method recording an event of a lane, only the thread owning the lane may call it
+     @param id lane, TRACE_MAIN for the thread running the method
+     @param kind what the lane was doing
+     @param generation step of the run
+     @param begin start of the event
+     @param end end of the event
+    */
+    inline void record(int id, TraceKind kind, int generation, uint64_t begin, uint64_t end)
+    {
+        Lane &l = lane(id);
+        if (kind == TRACE_COMPUTE && l.size > 0)
+        {
+            TraceEvent &last = l.events[l.size - 1];
+            if (last.kind == TRACE_COMPUTE && last.generation == generation)
+            {
+                last.end = end;
+                last.busy += end - begin;
+                return;
+            }
+        }
+        if (l.size == l.events.size())
+        {
+            l.dropped++;
+            return;
+        }
+        l.events[l.size++] = TraceEvent{begin, end, end - begin, generation, kind};
+    }
+
+    /**
+     Method recording the time a lane waited since its last event, used where the waiting happens in a runtime
+     (FastFlow, OpenMP) instead of in our code
+     @param id lane
+     @param generation step the lane was waiting for
+     @param end end of the wait
+    */
+    inline void idle(int id, int generation, uint64_t end)
+    {
+        Lane &l = lane(id);
+        uint64_t begin = l.size > 0 ? l.events[l.size - 1].end : origin;
+        if (end > begin)
+            record(id, TRACE_WAIT, generation, begin, end);
+    }
+
+    /**
+     Method closing a generation computed under a fork-join runtime: every worker that computed it waited from
+     its last event until end. It has to be called once the workers are done with the generation
+     @param generation step of the run
+     @param end time the generation was complete
+    */
+    void closeGeneration(int generation, uint64_t end)
+    {
+        for (size_t id = 0; id + 1 < lanes.size(); id++)
+            if (lanes[id].size > 0 && lanes[id].events[lanes[id].size - 1].generation == generation)
+                idle(id, generation, end);
+    }
+
+    inline bool empty() const { return lanes.empty(); }
+
+    /**
+     Method writing the trace of the last run in the Chrome trace format, one track per lane
+     @param path output file
+    */
+    void writeChromeTrace(const std::string &path) const
+    {
+        static const char *kinds[] = {"compute", "wait", "swap"};
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << "Error: can't open the trace file " << path << std::endl;
+            exit(-1);
+        }
+        file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+        file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": {\"name\": \"" << name << "\"}}";
+        char buffer[256];
+        for (size_t id = 0; id < lanes.size(); id++)
+        {
+            std::string lane_name = id + 1 == lanes.size() ? "main" : "worker " + std::to_string(id);
+            file << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << id
+                 << ", \"args\": {\"name\": \"" << lane_name << "\"}}";
+            for (size_t e = 0; e < lanes[id].size; e++)
+            {
+                const TraceEvent &ev = lanes[id].events[e];
+                //Microseconds, as the format expects
+                std::snprintf(buffer, sizeof(buffer),
+                              ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %zu, \"ts\": %.3f, \"dur\": %.3f, "
+                              "\"args\": {\"generation\": %d, \"busy_us\": %.3f}}",
+                              kinds[ev.kind], id, (ev.begin - origin) / 1e3, (ev.end - ev.begin) / 1e3, ev.generation, ev.busy / 1e3);
+                file << buffer;
+            }
+        }
+        file << "\n]}\n";
+    }
+
+    /**
+     Method summarizing the last run: time each lane spent computing, waiting and swapping
+     @returns a table, one row per lane and the total
+    */
+    std::string summary() const
+    {
+        std::string table = "Trace of " + name + "\n";
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), "%-10s %12s %12s %12s %9s %8s %8s\n", "lane", "compute ms", "wait ms",
+                      "swap ms", "compute%", "events", "dropped");
+        table += buffer;
+        double totals[3] = {0, 0, 0};
+        long events = 0, dropped = 0;
+        for (size_t id = 0; id < lanes.size(); id++)
+        {
+            double times[3] = {0, 0, 0};
+            for (size_t e = 0; e < lanes[id].size; e++)
+            {
+                const TraceEvent &ev = lanes[id].events[e];
+                times[ev.kind] += ev.busy / 1e6;
+                //The gaps of a merged compute event are waits
+                times[TRACE_WAIT] += (ev.end - ev.begin - ev.busy) / 1e6;
+            }
+            double total = times[0] + times[1] + times[2];
+            std::string lane_name = id + 1 == lanes.size() ? "main" : "worker " + std::to_string(id);
+            std::snprintf(buffer, sizeof(buffer), "%-10s %12.3f %12.3f %12.3f %9.1f %8zu %8ld\n", lane_name.c_str(),
+                          times[0], times[1], times[2], total > 0 ? 100 * times[0] / total : 0.0, lanes[id].size,
+                          lanes[id].dropped);
+            table += buffer;
+            for (int k = 0; k < 3; k++)
+                totals[k] += times[k];
+            events += lanes[id].size;
+            dropped += lanes[id].dropped;
+        }
+        double total = totals[0] + totals[1] + totals[2];
+        std::snprintf(buffer, sizeof(buffer), "%-10s %12.3f %12.3f %12.3f %9.1f %8ld %8ld\n", "total", totals[0],
+                      totals[1], totals[2], total > 0 ? 100 * totals[0] / total : 0.0, events, dropped);
+        table += buffer;
+        return table;
+    }
+};
+
+/*
+ Macros used by the run methods, they compile to nothing without CA_TRACE
+*/
+#ifdef CA_TRACE
+#define TRACE_RUN(tracer, run, workers, events) (tracer).begin(run, workers, events)
+#define TRACE_TIME(since) uint64_t since = Tracer::now()
+#define TRACE_RECORD(tracer, id, kind, generation, since) (tracer).record(id, kind, generation, since, Tracer::now())
+#define TRACE_IDLE(tracer, id, generation) (tracer).idle(id, generation, Tracer::now())
+#define TRACE_CLOSE(tracer, generation) (tracer).closeGeneration(generation, Tracer::now())
+#else
+#define TRACE_RUN(tracer, run, workers, events) ((void)0)
+#define TRACE_TIME(since)
+#define TRACE_RECORD(tracer, id, kind, generation, since) ((void)0)
+#define TRACE_IDLE(tracer, id, generation) ((void)0)
+#define TRACE_CLOSE(tracer, generation) ((void)0)
+#endif
+
+#endif